@@ -0,0 +1,43 @@
+#include <chrono>
+#include <iostream>
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "FixedIntegrator.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Compares the dynamic Integrator with FixedIntegrator<DampedOscillator, 2>
+// on the same trajectory and reports steps per second and the speedup.
+int main() {
+    // Undamped, so the state stays O(1) and never reaches denormal range over the long run
+    DampedOscillator oscillator(1.0, 0.0);
+
+    const double dt = 0.001;
+    const double t0 = 0.0;
+    const double tf = 20000.0;
+    const double num_steps = (tf - t0) / dt;
+
+    Vec y_dynamic(2);
+    y_dynamic << 0.2, -2.0;
+    Vec y_fixed = y_dynamic;
+
+    Integrator dynamic_integrator(oscillator, dt);
+    dynamic_integrator.setOutputInterval(1.0);
+    auto start = std::chrono::steady_clock::now();
+    dynamic_integrator.integrate(y_dynamic, t0, tf);
+    double dynamic_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    FixedIntegrator<DampedOscillator, 2> fixed_integrator(oscillator, dt);
+    fixed_integrator.setOutputInterval(1.0);
+    start = std::chrono::steady_clock::now();
+    fixed_integrator.integrate(y_fixed, t0, tf);
+    double fixed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "steps:              " << num_steps << "\n";
+    std::cout << "Integrator:         " << num_steps / dynamic_seconds << " steps/s\n";
+    std::cout << "FixedIntegrator<2>: " << num_steps / fixed_seconds << " steps/s\n";
+    std::cout << "speedup:            " << dynamic_seconds / fixed_seconds << "x\n";
+    std::cout << "max |difference|:   "
+              << (dynamic_integrator.getResults() - fixed_integrator.getResults()).cwiseAbs().maxCoeff() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Definitions.hpp"
+#include "DynamicalSystem.hpp"
+#include "Integrator.hpp"
+#include "NetworkSystem.hpp"
+#include "ParameterSweep.hpp"
+#include "systems/DampedOscillator.hpp"
+#include "systems/Lorenz.hpp"
+#include "systems/Pendulum.hpp"
+
+// Micro-benchmarks of the RK4 hot path, of NetworkSystem::rhs() and of ParameterSweep throughput,
+// plus energy error versus cost of RK4 and the symplectic methods on a long pendulum run.
+// Every result is printed as one JSON object per line (JSON Lines), so runs can be
+// appended to a file and compared over time:
+//
+//     ./bench_integrator                  # print to stdout
+//     ./bench_integrator results.jsonl    # additionally append to a file
+
+namespace {
+    // Lorenz-96 model of arbitrary dimension (>= 4), used for the larger sizes
+    class Lorenz96 : public DynamicalSystem {
+    public:
+        explicit Lorenz96(int n, double forcing = 8.0) {
+            dim = n;
+            defineParameter("F", forcing);
+        }
+
+        void rhs(double t, const Vec& y, Vec& dydt) override {
+            const int n = dim;
+            const double forcing = parameters_[0];
+            for (int i = 0; i < n; ++i) {
+                dydt[i] = (y[(i + 1) % n] - y[(i + n - 2) % n]) * y[(i + n - 1) % n] - y[i] + forcing;
+            }
+        }
+    };
+
+    struct Output {
+        std::ofstream file;
+        void emit(const std::string& line) {
+            std::cout << line << std::endl;
+            if (file.is_open()) file << line << "\n";
+        }
+    };
+
+    void benchRK4(Output& out, const std::string& name, AbstractDynamicalSystem& system, bool recording) {
+        const double dt = 0.001;
+        const long long steps = std::max<long long>(2000, 4000000LL / system.dim);
+        Vec y = Vec::Constant(system.dim, 0.1);
+        y(0) = 1.0;
+
+        Integrator integrator(system, dt);
+        if (recording) integrator.setOutputInterval(dt);  // Record every step
+        integrator.integrate(y, 0.0, steps * dt);
+
+        const IntegratorStats& stats = integrator.getStats();
+        const double seconds = stats.transient_seconds + stats.recording_seconds;
+        std::ostringstream line;
+        line << "{\"benchmark\":\"rk4\",\"system\":\"" << name << "\",\"dim\":" << system.dim
+             << ",\"recording\":" << (recording ? "true" : "false")
+             << ",\"steps_per_second\":" << stats.steps_taken / seconds
+             << ",\"ns_per_rhs\":" << 1e9 * seconds / stats.rhs_evaluations
+             << ",\"stats\":" << stats.toJSON() << "}";
+        out.emit(line.str());
+    }
+
+    // Ring of 10^5 diffusively coupled oscillators (2 * 10^5 state variables)
+    void benchNetworkRhs(Output& out, int num_threads) {
+        const int n = 100000;
+        std::vector<Eigen::Triplet<double>> entries;
+        for (int i = 0; i < n; ++i) {
+            entries.emplace_back(i, (i + n - 1) % n, 1.0);
+            entries.emplace_back(i, i, -2.0);
+            entries.emplace_back(i, (i + 1) % n, 1.0);
+        }
+        SparseMat laplacian(n, n);
+        laplacian.setFromTriplets(entries.begin(), entries.end());
+        NetworkSystem<DampedOscillator, 2> network(DampedOscillator(1.0, 0.0), laplacian, 0.1, 0, 1);
+        network.setNumThreads(num_threads);
+
+        Vec y = Vec::Random(network.dim), dydt(network.dim);
+        const int repeats = 200;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) network.rhs(0.0, y, dydt);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::ostringstream line;
+        line << "{\"benchmark\":\"network_rhs\",\"system\":\"NetworkSystem<DampedOscillator>\",\"dim\":" << network.dim
+             << ",\"threads\":" << num_threads << ",\"ns_per_rhs\":" << 1e9 * seconds / repeats
+             << ",\"ns_per_state\":" << 1e9 * seconds / repeats / network.dim << "}";
+        out.emit(line.str());
+    }
+
+    // Maximum energy error over 10^4 time units (sampled every time unit) against wall time
+    // and force evaluations, for a range of step sizes per method
+    void benchEnergyError(Output& out) {
+        using Method = Integrator::Method;
+        const std::pair<Method, const char*> methods[] = {{Method::RK4, "rk4"},
+                                                          {Method::VelocityVerlet, "velocity_verlet"},
+                                                          {Method::Yoshida4, "yoshida4"},
+                                                          {Method::Yoshida6, "yoshida6"}};
+        Pendulum pendulum(1.0);
+        Vec y0(2);
+        y0 << 2.0, 0.0;
+        const double energy0 = pendulum.energy(y0);
+
+        for (const auto& method : methods) {
+            for (double dt : {0.4, 0.2, 0.1, 0.05, 0.025}) {
+                Vec y = y0;
+                Integrator integrator(pendulum, dt);
+                integrator.setMethod(method.first);
+                integrator.setOutputInterval(1.0);
+                integrator.integrate(y, 0.0, 1e4);
+
+                double max_error = 0.0;
+                const Mat& samples = integrator.getResults();
+                for (Index k = 0; k < samples.cols(); ++k) {
+                    max_error = std::max(max_error, std::abs(pendulum.energy(samples.col(k)) - energy0));
+                }
+                const IntegratorStats& stats = integrator.getStats();
+                std::ostringstream line;
+                line << "{\"benchmark\":\"energy_error\",\"system\":\"Pendulum\",\"method\":\"" << method.second
+                     << "\",\"dt\":" << dt << ",\"max_energy_error\":" << max_error
+                     << ",\"rhs_evaluations\":" << stats.rhs_evaluations
+                     << ",\"seconds\":" << stats.transient_seconds + stats.recording_seconds << "}";
+                out.emit(line.str());
+            }
+        }
+    }
+
+    void benchSweep(Output& out, int num_threads) {
+        DampedOscillator oscillator(1.0, 0.1);
+        ParameterSweep sweep(oscillator, "gamma");
+        sweep.setParameterRange(0.0, 1.0, 256);
+        sweep.setTimeStep(0.01);
+        sweep.setTransientTime(50.0);
+        sweep.setOutputInterval(0.1);
+        sweep.setNumThreads(num_threads);
+        sweep.setPostProcessingFunction([](const Mat& result) {
+            Vec out(1);
+            out(0) = result.row(0).cwiseAbs().maxCoeff();
+            return out;
+        });
+
+        Vec y0(2);
+        y0 << 1.0, 0.0;
+        auto start = std::chrono::steady_clock::now();
+        sweep.runSweep(y0, 0.0, 150.0);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::ostringstream line;
+        line << "{\"benchmark\":\"parameter_sweep\",\"system\":\"DampedOscillator\",\"threads\":" << num_threads
+             << ",\"points\":256,\"points_per_second\":" << 256 / seconds << ",\"seconds\":" << seconds << "}";
+        out.emit(line.str());
+    }
+}
+
+int main(int argc, char** argv) {
+    Output out;
+    if (argc > 1) {
+        out.file.open(argv[1], std::ios::app);
+        if (!out.file.is_open()) {
+            std::cerr << "Failed to open file: " << argv[1] << std::endl;
+            return 1;
+        }
+    }
+
+    DampedOscillator oscillator(1.0, 0.0);
+    Lorenz lorenz;
+    Lorenz96 lorenz96_10(10), lorenz96_100(100), lorenz96_1000(1000);
+
+    for (bool recording : {false, true}) {
+        benchRK4(out, "DampedOscillator", oscillator, recording);
+        benchRK4(out, "Lorenz", lorenz, recording);
+        benchRK4(out, "Lorenz96", lorenz96_10, recording);
+        benchRK4(out, "Lorenz96", lorenz96_100, recording);
+        benchRK4(out, "Lorenz96", lorenz96_1000, recording);
+    }
+
+    int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+    benchNetworkRhs(out, 1);
+    if (hardware_threads > 1) benchNetworkRhs(out, hardware_threads);
+
+    benchSweep(out, 1);
+    if (hardware_threads > 1) benchSweep(out, hardware_threads);
+
+    benchEnergyError(out);
+
+    return 0;
+}
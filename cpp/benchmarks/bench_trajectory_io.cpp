@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "TrajectoryIO.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Compares writing a trajectory as CSV and in the binary columnar format,
+// and reading it back through the memory-mapped reader.
+int main() {
+    DampedOscillator oscillator(1.0, 0.0);
+
+    Vec y(2);
+    y << 0.2, -2.0;
+    Integrator integrator(oscillator, 0.01);
+    integrator.setOutputInterval(0.01);
+    integrator.integrate(y, 0.0, 20000.0);
+    const double num_samples = static_cast<double>(integrator.getResults().cols());
+    const double megabytes = num_samples * 3 * sizeof(double) / 1e6;  // time + 2 states
+
+    auto seconds_since = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string csv_file = (dir / "nldkit_bench_trajectory.csv").string();
+    const std::string binary_file = (dir / "nldkit_bench_trajectory.nldk").string();
+
+    auto start = std::chrono::steady_clock::now();
+    integrator.writeResultsToCSV(csv_file);
+    double csv_seconds = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    integrator.writeResultsToBinary(binary_file);
+    double binary_seconds = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    MappedTrajectory mapped(binary_file);
+    double checksum = mapped.times().sum() + mapped.columns().sum();
+    double read_seconds = seconds_since(start);
+
+    std::cout << "samples:            " << num_samples << "\n";
+    std::cout << "CSV write:          " << megabytes / csv_seconds << " MB/s, "
+              << std::filesystem::file_size(csv_file) / 1e6 << " MB on disk\n";
+    std::cout << "binary write:       " << megabytes / binary_seconds << " MB/s, "
+              << std::filesystem::file_size(binary_file) / 1e6 << " MB on disk\n";
+    std::cout << "mmap read + reduce: " << megabytes / read_seconds << " MB/s (checksum " << checksum << ")\n";
+    std::cout << "write speedup:      " << csv_seconds / binary_seconds << "x" << std::endl;
+
+    std::remove(csv_file.c_str());
+    std::remove(binary_file.c_str());
+    return 0;
+}
@@ -1,15 +1,26 @@
 #pragma once
 
 #include "Definitions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <string>
 #include <stdexcept>
 
+// Resolved parameter: index into a system's contiguous parameter array.
+// Obtain once by name with getParameterHandle(); valid for the system and its clones.
+using ParamHandle = int;
+
 class AbstractDynamicalSystem {
 public:
 
     virtual ~AbstractDynamicalSystem() = default;
 
     int dim = 0;  // System dimension; must be set by each concrete system.
+
+    // Right-hand side f(t, y). Integrators pass dydt already sized to dim and call this in
+    // their hot loop, so implementations should write into it without resizing or allocating.
     virtual void rhs(double t, const Vec& y, Vec& dydt) = 0;
 
     // Set a named parameter to a value (default: throws if unsupported)
@@ -21,4 +32,141 @@ public:
     virtual double getParameter(const std::string& name) const {
         throw std::runtime_error("getParameter() not implemented for this system.");
     }
+
+    // Resolve a parameter name to its handle (default: throws if unsupported)
+    virtual ParamHandle getParameterHandle(const std::string& name) const {
+        throw std::runtime_error("getParameterHandle() not implemented for this system.");
+    }
+
+    // Whether getParameterHandle() and the handle accessors are implemented. Systems with
+    // by-name accessors only can still be swept, through the by-name path.
+    virtual bool hasParameterHandles() const {
+        return false;
+    }
+
+    // Handle of `name`, or -1 if the system has no handles
+    ParamHandle resolveParameter(const std::string& name) const {
+        return hasParameterHandles() ? getParameterHandle(name) : -1;
+    }
+
+    // Sets a parameter resolved by resolveParameter(): by handle when there is one, by name otherwise
+    void setResolvedParameter(ParamHandle handle, const std::string& name, double value) {
+        if (handle >= 0) {
+            setParameter(handle, value);
+        } else {
+            setParameter(name, value);
+        }
+    }
+
+    // Set a parameter by handle in O(1) without allocation (default: throws if unsupported)
+    virtual void setParameter(ParamHandle handle, double value) {
+        throw std::runtime_error("setParameter() not implemented for this system.");
+    }
+
+    // Get a parameter's value by handle (default: throws if unsupported)
+    virtual double getParameter(ParamHandle handle) const {
+        throw std::runtime_error("getParameter() not implemented for this system.");
+    }
+
+    // Jacobian df/dy of the right-hand side at (t, y), written into J (dim × dim).
+    // Default: forward finite differences of rhs(), costing dim + 1 evaluations.
+    // Systems with a known Jacobian should override this.
+    virtual void jacobian(double t, const Vec& y, Mat& J) {
+        if (jacobian_kind_ == JacobianKind::Probing) jacobian_kind_ = JacobianKind::FiniteDifference;
+        if (fd_f0_.size() != dim) fd_f0_.resize(dim);
+        rhs(t, y, fd_f0_);
+        finiteDifferenceJacobian(t, y, fd_f0_, J);
+    }
+
+    // Jacobian at (t, y) for a caller that already holds f = rhs(t, y). The first call
+    // finds out whether jacobian() is the finite-difference default; from then on f replaces
+    // its base evaluation (dim evaluations instead of dim + 1). Analytic Jacobians are
+    // called as they are.
+    void jacobianWithRhs(double t, const Vec& y, const Vec& f, Mat& J) {
+        if (jacobian_kind_ == JacobianKind::FiniteDifference) {
+            finiteDifferenceJacobian(t, y, f, J);
+            return;
+        }
+        if (jacobian_kind_ != JacobianKind::Analytic) {
+            jacobian_kind_ = JacobianKind::Probing;
+            jacobian(t, y, J);
+            if (jacobian_kind_ == JacobianKind::Probing) jacobian_kind_ = JacobianKind::Analytic;
+            return;
+        }
+        jacobian(t, y, J);
+    }
+
+    // Sparse Jacobian df/dy at (t, y), written into J (dim × dim). Used by StiffIntegrator;
+    // large systems with a known sparsity pattern should override this and keep the pattern
+    // fixed between calls so the symbolic LU analysis can be reused.
+    // Default: sparse view of jacobian().
+    virtual void sparseJacobian(double t, const Vec& y, SparseMat& J) {
+        Mat J_dense;
+        jacobian(t, y, J_dense);
+        J = J_dense.sparseView();
+    }
+
+    // Whether rhsBatch() is implemented; enables the ensemble integration path
+    virtual bool hasBatchRhs() const {
+        return false;
+    }
+
+    // Right-hand side for a whole ensemble: Y and dYdt are dim × N blocks, one column
+    // per member (default: throws if unsupported)
+    virtual void rhsBatch(double t, const BatchMat& Y, BatchMat& dYdt) {
+        throw std::runtime_error("rhsBatch() not implemented for this system.");
+    }
+
+    // Set per-member values of a named parameter for rhsBatch(); values.size() must
+    // equal the ensemble size, and an empty array clears them (default: throws if unsupported)
+    virtual void setParameterBatch(const std::string& name, const Arr& values) {
+        throw std::runtime_error("setParameterBatch() not implemented for this system.");
+    }
+
+    // Whether positionRhs() and momentumRhs() are implemented; enables the symplectic
+    // methods of Integrator
+    virtual bool hasSplitRhs() const {
+        return false;
+    }
+
+    // Split right-hand side of a separable Hamiltonian system H = T(p) + V(q, t). The state
+    // is y = [q; p], both halves of size dim / 2, and rhs() must equal the two halves stacked.
+    // positionRhs() writes dq/dt = dT/dp and may only read p; momentumRhs() writes
+    // dp/dt = -dV/dq and may only read q (default: throw if unsupported).
+    virtual void positionRhs(double t, const Vec& y, Vec& dqdt) {
+        throw std::runtime_error("positionRhs() not implemented for this system.");
+    }
+
+    virtual void momentumRhs(double t, const Vec& y, Vec& dpdt) {
+        throw std::runtime_error("momentumRhs() not implemented for this system.");
+    }
+
+    // Create an independent copy of the system, including its current parameters.
+    // Required by multi-threaded sweeps, where every worker integrates its own copy
+    // (default: throws if unsupported)
+    virtual std::unique_ptr<AbstractDynamicalSystem> clone() const {
+        throw std::runtime_error("clone() not implemented for this system.");
+    }
+
+private:
+    // Forward differences around f = rhs(t, y) into J; the scratch buffers are sized on
+    // first use, so repeated calls (e.g. at every stage of a variational integration) do
+    // not allocate
+    void finiteDifferenceJacobian(double t, const Vec& y, const Vec& f, Mat& J) {
+        if (J.rows() != dim || J.cols() != dim) J.resize(dim, dim);
+        if (fd_f1_.size() != dim) fd_f1_.resize(dim);
+        fd_y_ = y;
+        const double sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+        for (int j = 0; j < dim; ++j) {
+            const double h = sqrt_eps * std::max(1.0, std::abs(y[j]));
+            fd_y_[j] = y[j] + h;
+            rhs(t, fd_y_, fd_f1_);
+            J.col(j) = (fd_f1_ - f) / h;
+            fd_y_[j] = y[j];
+        }
+    }
+
+    enum class JacobianKind { Unknown, Probing, FiniteDifference, Analytic };
+    JacobianKind jacobian_kind_ = JacobianKind::Unknown;  // What jacobian() resolves to
+    Vec fd_f0_, fd_f1_, fd_y_;  // Finite-difference scratch
 };
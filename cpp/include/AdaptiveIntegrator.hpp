@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+#include "IntegratorStats.hpp"
+
+// AdaptiveIntegrator class: performs numerical integration using the Dormand–Prince 5(4)
+// embedded Runge–Kutta method with error-controlled step size and FSAL stage reuse.
+// Samples on the output grid are filled by the 4th-order dense output of each accepted
+// step, so step sizes are never shortened to land on output times.
+//
+// The sample grid matches Integrator: samples at t_rec + k * interval (k = 1, 2, ...) up
+// to tf, where t_rec = max(t0, transient time) is the end of the transient phase.
+
+class AdaptiveIntegrator {
+public:
+    AdaptiveIntegrator(AbstractDynamicalSystem& system, double initial_dt);  // Constructor with system reference and first trial step
+    void integrate(Vec& y, double t0, double tf);                            // Runs integration from t0 to tf
+
+    void writeResultsToCSV(const std::string& filename) const;  // Writes the integration results into a CSV file
+    void setTransientTime(double t_transient);               // Sets transient phase duration (no recording)
+    void setOutputInterval(double interval);                 // Sets output sampling interval
+    void setTolerances(double rel_tol, double abs_tol);      // Sets relative and absolute local error tolerances
+    void setMaxStep(double max_dt);                          // Limits the step size (default: unlimited)
+    const Mat& getResults() const;                           // Returns matrix of saved results (dim × num_samples)
+    const Vec& getTimes() const;                             // Returns vector of saved timestamps
+
+    long long getRhsEvaluations() const;                     // Right-hand side calls made by the last integrate()
+    long long getAcceptedSteps() const;                      // Accepted steps of the last integrate()
+    long long getRejectedSteps() const;                      // Rejected steps of the last integrate()
+    const IntegratorStats& getStats() const;                 // Counters and phase timings of the last integrate()
+
+private:
+    // Evaluates the dense output of the current step at t_out into y_out
+    void interpolate(double t_out, double t_old, double h, Eigen::Ref<Vec> y_out) const;
+
+    AbstractDynamicalSystem& system_;  // Reference to the system being integrated
+    double initial_dt_;                // First trial step size
+
+    double t_transient_ = 0.0;         // Transient integration time
+    double output_interval_ = -1.0;    // Output sampling interval; -1 means no output recording
+    double rel_tol_ = 1e-6;            // Relative local error tolerance
+    double abs_tol_ = 1e-9;            // Absolute local error tolerance
+    double max_dt_ = 0.0;              // Maximum step size; 0 means unlimited
+    Mat results_;                      // Stores results: (dim × num_samples)
+    Vec times_;                        // Stores corresponding times: (num_samples)
+
+    IntegratorStats stats_;            // Counters of the last integrate()
+
+    // Internal stage buffers (pre-allocated for performance)
+    Vec k1_, k2_, k3_, k4_, k5_, k6_, k7_, y_new_, y_temp_;
+    // Dense output coefficients of the current step
+    Vec r1_, r2_, r3_, r4_, r5_;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Binary checkpoint format (.ckpt)
+//
+//   magic "NLDKCKP\0", uint32 version, uint32 kind, uint64 payload size,
+//   payload, uint64 FNV-1a checksum of the payload
+//
+// The payload is a flat sequence of native-endian values written and read back in the
+// same order by the owner of the checkpoint (Integrator, ParameterSweep). Files are
+// replaced atomically: written to "<file>.tmp", synced, then renamed over "<file>", so a
+// crash during a write leaves the previous checkpoint intact.
+
+enum class CheckpointKind : std::uint32_t {
+    Integrator = 1,
+    ParameterSweep = 2
+};
+
+// Serialised checkpoint payload with sequential put/get access
+class CheckpointData {
+public:
+    explicit CheckpointData(CheckpointKind kind);
+
+    // Reads and validates a checkpoint file; throws std::runtime_error if it is missing,
+    // truncated, corrupted or of another kind
+    static CheckpointData load(const std::string& filename, CheckpointKind kind);
+
+    template <typename T>
+    void put(const T& value) {
+        const char* p = reinterpret_cast<const char*>(&value);
+        payload_.insert(payload_.end(), p, p + sizeof(T));
+    }
+    void putArray(const double* data, Index size);  // Raw values, no size prefix
+    void putVec(const Vec& v);                      // Size followed by the values
+    void putMat(const Mat& m);                      // Rows, cols, then column-major values
+
+    template <typename T>
+    T get() {
+        T value;
+        require(sizeof(T));
+        std::memcpy(&value, payload_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return value;
+    }
+    void getArray(double* data, Index size);
+    Vec getVec();
+    Mat getMat();
+
+    CheckpointKind kind() const;
+    std::vector<char> serialize() const;  // Complete file contents including header and checksum
+
+private:
+    void require(std::size_t bytes) const;
+
+    CheckpointKind kind_;
+    std::vector<char> payload_;
+    std::size_t offset_ = 0;  // Read cursor
+};
+
+// Writes a serialised checkpoint synchronously with the temp-file-and-rename protocol
+void writeCheckpointFile(const std::string& filename, const std::vector<char>& bytes);
+
+// Appends `bytes` to `filename` (created if missing) and syncs it
+void appendToFile(const std::string& filename, const std::vector<char>& bytes);
+
+// Truncates or extends `filename` to `bytes` bytes, creating it if missing
+void resizeFile(const std::string& filename, std::uint64_t bytes);
+
+// CheckpointWriter class: writes checkpoints on a background thread so the integration
+// loop only pays for serialising into memory. submit() never waits for I/O: if a write is
+// still running, the new checkpoint replaces any older one waiting behind it. Data queued
+// with append() is never dropped and reaches its file before any checkpoint submitted
+// after it, so a checkpoint can refer to an append-only log written alongside it.
+class CheckpointWriter {
+public:
+    CheckpointWriter();
+    ~CheckpointWriter();  // Writes the pending checkpoint, then stops the thread
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(const std::string& filename, std::vector<char> bytes);
+    void append(const std::string& filename, const std::vector<char>& bytes);
+    void flush();  // Blocks until every submitted checkpoint and append is on disk; rethrows write errors
+
+private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::string pending_file_;
+    std::vector<char> pending_bytes_;
+    bool has_pending_ = false;
+    std::vector<std::pair<std::string, std::vector<char>>> pending_appends_;  // In submission order
+    bool busy_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread thread_;
+};
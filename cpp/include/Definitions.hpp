@@ -30,6 +30,10 @@ using CMat        = Eigen::MatrixXcd;
 using Arr         = Eigen::ArrayXd;
 using Arr2D       = Eigen::ArrayXXd;
 
+// Ensemble block (dim × N, row-major): each state component is stored
+// contiguously across all ensemble members (structure of arrays)
+using BatchMat    = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
 // Sparse matrix (optional if needed)
 using SparseMat   = Eigen::SparseMatrix<double>;
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "ResultStore.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Distributed sweep execution over a local (Unix domain) socket.
+//
+// The coordinator owns the output ResultStore and splits the points [0, num_points) into
+// chunks. Workers (separate processes, started by the user or a job scheduler) connect,
+// receive one chunk at a time, evaluate its points and send the processed results back.
+// Both sides derive the parameter values of a point from its index, so only index ranges
+// and results travel over the socket.
+//
+// A worker that disconnects (crash, preemption) or, with a timeout set, stays silent too
+// long loses its chunk, which is handed to the next idle worker. The sweep finishes once
+// every chunk is stored; idle workers then receive a stop message.
+//
+// Messages are native-endian: uint32 type, uint64 first point, uint64 count, uint64
+// payload size, payload. Workers send REQUEST and RESULT (payload: uint64 result_dim,
+// result_dim × count doubles); the coordinator answers with WORK or STOP.
+
+class SweepCoordinator {
+public:
+    struct Stats {
+        Index chunks = 0;              // Chunks in the sweep
+        Index dispatched = 0;          // Chunk assignments, including re-dispatches
+        Index redispatched = 0;        // Chunks re-queued after a worker failure
+        Index workers = 0;             // Worker connections accepted
+        Index failed_workers = 0;      // Connections lost or timed out while holding a chunk
+    };
+
+    // Binds and listens on socket_path (an existing socket file is replaced)
+    SweepCoordinator(const std::string& socket_path, Index num_points, Index chunk_points = 256);
+    ~SweepCoordinator();  // Closes all connections and removes the socket file
+
+    SweepCoordinator(const SweepCoordinator&) = delete;
+    SweepCoordinator& operator=(const SweepCoordinator&) = delete;
+
+    // A worker holding a chunk for longer than this is considered failed (0: no limit)
+    void setWorkerTimeout(double seconds);
+
+    // Serves chunks until all points are stored. The store is begun with the coordinates
+    // and axis names once the first result fixes the result size.
+    void run(ResultStore& store, const Mat& coordinates, const std::vector<std::string>& axis_names);
+
+    const Stats& getStats() const;
+
+private:
+    struct Connection;
+
+    void accept();
+    bool assign(Connection& connection);               // Sends the next chunk or parks the worker
+    void fail(Connection& connection);                 // Re-queues the chunk of a lost worker
+    bool handleMessages(Connection& connection, ResultStore& store, const Mat& coordinates,
+                        const std::vector<std::string>& axis_names);
+
+    std::string socket_path_;
+    int listen_fd_ = -1;
+    Index num_points_;
+    Index chunk_points_;
+    double worker_timeout_ = 0.0;
+
+    std::vector<Index> queue_;              // Chunks waiting for a worker (back is next)
+    std::vector<std::uint8_t> chunk_done_;
+    Index chunks_left_ = 0;
+    bool store_begun_ = false;
+    std::vector<Connection> connections_;
+    Stats stats_;
+};
+
+class SweepWorker {
+public:
+    // Processed result of one point, given its index
+    using PointEvaluator = std::function<Vec(Index point)>;
+    // Processed results of the points [first, first + count), one column per point
+    using ChunkEvaluator = std::function<Mat(Index first, Index count)>;
+
+    // Connects to the coordinator, retrying for up to connect_timeout seconds
+    explicit SweepWorker(const std::string& socket_path, double connect_timeout = 10.0);
+    ~SweepWorker();
+
+    SweepWorker(const SweepWorker&) = delete;
+    SweepWorker& operator=(const SweepWorker&) = delete;
+
+    // Evaluates chunks until the coordinator stops the sweep; returns the points evaluated
+    Index run(const PointEvaluator& evaluate);
+    Index run(const ChunkEvaluator& evaluate);
+
+private:
+    int fd_ = -1;
+};
@@ -4,25 +4,47 @@
 #include <map>
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 class DynamicalSystem : public AbstractDynamicalSystem {
 public:
     DynamicalSystem() = default;
     ~DynamicalSystem() override = default;
 
+    // By-name access is a compatibility layer over the handle registry: every call
+    // resolves the name first. Hot loops should resolve a handle once instead.
+    // Unknown names throw std::invalid_argument.
     void setParameter(const std::string& name, double value) override {
-        parameters_[name] = value;
+        parameters_[getParameterHandle(name)] = value;
     }
 
     double getParameter(const std::string& name) const override {
-        auto it = parameters_.find(name);
-        if (it != parameters_.end()) {
+        return parameters_[getParameterHandle(name)];
+    }
+
+    bool hasParameterHandles() const override {
+        return true;
+    }
+
+    ParamHandle getParameterHandle(const std::string& name) const override {
+        auto it = parameter_handles_.find(name);
+        if (it != parameter_handles_.end()) {
             return it->second;
         } else {
             throw std::invalid_argument("Unknown parameter: " + name);
         }
     }
 
+    void setParameter(ParamHandle handle, double value) override {
+        checkHandle(handle);
+        parameters_[handle] = value;
+    }
+
+    double getParameter(ParamHandle handle) const override {
+        checkHandle(handle);
+        return parameters_[handle];
+    }
+
     /**
      * @brief Computes the right-hand side of the dynamical system.
      * 
@@ -37,5 +59,45 @@ public:
     void rhs(double t, const Vec& y, Vec& dydt) override = 0;
 
 protected:
-    std::map<std::string, double> parameters_;
-};
\ No newline at end of file
+    /**
+     * @brief Registers a parameter with its initial value and returns its handle.
+     *
+     * Concrete systems declare all their parameters in the constructor; handles are
+     * assigned consecutively from 0 in declaration order. Defining a name twice
+     * throws std::invalid_argument.
+     */
+    ParamHandle defineParameter(const std::string& name, double value) {
+        if (parameter_handles_.count(name)) {
+            throw std::invalid_argument("Parameter already defined: " + name);
+        }
+        ParamHandle handle = static_cast<ParamHandle>(parameters_.size());
+        parameters_.push_back(value);
+        parameter_handles_[name] = handle;
+        return handle;
+    }
+
+    /**
+     * @brief Sets a parameter by name, declaring it first if it is unknown.
+     *
+     * For constructors written before the registry, which set their parameters by name
+     * instead of declaring them; new systems use defineParameter().
+     */
+    void declareOrSet(const std::string& name, double value) {
+        auto it = parameter_handles_.find(name);
+        if (it == parameter_handles_.end()) {
+            defineParameter(name, value);
+        } else {
+            parameters_[it->second] = value;
+        }
+    }
+
+    std::vector<double> parameters_;                         // Parameter values, indexed by handle
+    std::map<std::string, ParamHandle> parameter_handles_;   // Name -> handle, used only on the by-name path
+
+private:
+    void checkHandle(ParamHandle handle) const {
+        if (handle < 0 || handle >= static_cast<ParamHandle>(parameters_.size())) {
+            throw std::out_of_range("Invalid parameter handle: " + std::to_string(handle));
+        }
+    }
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+
+// EnsembleIntegrator class: integrates N members of the same system at once with RK4.
+// The ensemble is a dim × N structure-of-arrays block (BatchMat), so each RK4 stage is a
+// single vectorized rhsBatch() call and a set of contiguous lane-wise vector updates that
+// the compiler maps onto SIMD registers (AVX2/AVX-512 with NLDKIT_NATIVE_ARCH=ON).
+// Transient time and output sampling follow Integrator; without an output interval the
+// ensemble is still advanced to tf.
+
+class EnsembleIntegrator {
+public:
+    EnsembleIntegrator(AbstractDynamicalSystem& system, double dt);  // Constructor with system reference and time step
+    void integrate(BatchMat& Y, double t0, double tf);               // Runs integration of all members from t0 to tf
+
+    void setTransientTime(double t_transient);               // Sets transient phase duration (no recording)
+    void setOutputInterval(double interval);                 // Sets output sampling interval
+    const Mat& getResults() const;                           // Returns saved results: (dim * N × num_samples), row = component * N + member
+    const Vec& getTimes() const;                             // Returns vector of saved timestamps
+    Mat getMemberResults(Index member) const;                // Returns the trajectory of one member (dim × num_samples)
+
+private:
+    void step(double t, BatchMat& Y);  // One RK4 step of size dt_ for all members
+
+    AbstractDynamicalSystem& system_;  // Reference to the system being integrated
+    double dt_;                        // Integration time step
+
+    double t_transient_ = 0.0;         // Transient integration time
+    double output_interval_ = -1.0;    // Output sampling interval; -1 means no output recording
+    Mat results_;                      // Stores results: (dim * N × num_samples)
+    Vec times_;                        // Stores corresponding times: (num_samples)
+    Index members_ = 0;                // Ensemble size of the last integrate()
+
+    // Internal RK4 stage blocks (pre-allocated for performance)
+    BatchMat k1_, k2_, k3_, k4_, y_temp_;
+};
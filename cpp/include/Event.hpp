@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <functional>
+
+// Event: a zero crossing of a user-defined switching function g(t, y), detected by the
+// integrator after every step of the recording phase. Crossing times and states are refined
+// by root finding on the cubic Hermite interpolant of the step, so they are accurate to the
+// order of the integrator rather than to the step size.
+//
+// Typical switching functions: y[i] - c for a Poincaré section, dydt[i] for peaks of y[i],
+// or a distance to a target set combined with `terminal` to stop the integration.
+
+struct Event {
+    using SwitchingFunc = std::function<double(double t, const Vec& y)>;
+
+    enum class Direction {
+        Both,     // Any sign change
+        Rising,   // g goes from negative to non-negative
+        Falling   // g goes from positive to non-positive
+    };
+
+    SwitchingFunc g;                        // Switching function
+    Direction direction = Direction::Both;  // Crossings that count
+    bool terminal = false;                  // Stop integration at the first crossing
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// FixedIntegrator class: compile-time specialized RK4 integrator for systems of small,
+// known dimension N. The state and stage buffers are Eigen::Matrix<double, N, 1> values
+// held inside the integrator, and the right-hand side is called statically through
+//
+//     template <typename StateIn, typename StateOut>
+//     void System::evalRhs(double t, const StateIn& y, StateOut&& dydt) const;
+//
+// so the step loop performs no heap allocation and no virtual dispatch. Transient time,
+// output interval, result layout and the advance to tf without output recording follow
+// Integrator with its default RK4 method.
+
+template <typename System, int N>
+class FixedIntegrator {
+public:
+    using State = Eigen::Matrix<double, N, 1>;
+
+    FixedIntegrator(System& system, double dt)  // Constructor with system reference and time step
+        : system_(system), dt_(dt) {
+        if (system_.dim != N) {
+            throw std::invalid_argument("FixedIntegrator: system dimension does not match template dimension N.");
+        }
+    }
+
+    // Runs integration from t0 to tf
+    void integrate(State& y, double t0, double tf) {
+        double t = t0;
+        const double dt_half = dt_ / 2.0;
+        const double dt_sixth = dt_ / 6.0;
+        int num_samples = (output_interval_ > 0.0)
+            ? static_cast<int>(std::floor((tf - t_transient_) / output_interval_)) + 1
+            : 0;
+
+        int steps_per_sample = 0;
+        if (output_interval_ > 0.0) {
+            steps_per_sample = static_cast<int>(std::round(output_interval_ / dt_));
+            if (steps_per_sample <= 0) steps_per_sample = 1;
+        }
+
+        int sample_idx = 0;
+
+        // Transient phase
+        while (t < t_transient_) {
+            step(t, y, dt_half, dt_sixth);
+            t += dt_;
+        }
+
+        long long max_steps = static_cast<long long>(std::ceil((tf - t) / dt_));
+
+        // Exact sample count, as in Integrator
+        if (num_samples > 0) {
+            const long long samples = (max_steps > 0) ? (max_steps + steps_per_sample - 1) / steps_per_sample : 1;
+            num_samples = static_cast<int>(std::min<long long>(num_samples, samples));
+        }
+        results_.resize(N, num_samples);
+        times_.resize(num_samples);
+
+        // Main phase
+        while (sample_idx < num_samples) {
+            for (int s = 0; s < steps_per_sample && max_steps > 0; ++s, --max_steps) {
+                step(t, y, dt_half, dt_sixth);
+                t += dt_;
+            }
+            results_.col(sample_idx) = y;
+            times_(sample_idx) = t;
+            sample_idx++;
+            if (max_steps <= 0) break;
+        }
+        // Without output recording the state is still advanced to tf
+        for (; num_samples == 0 && max_steps > 0; --max_steps) {
+            step(t, y, dt_half, dt_sixth);
+            t += dt_;
+        }
+    }
+
+    // Convenience overload for dynamically sized state vectors
+    void integrate(Vec& y, double t0, double tf) {
+        if (y.size() != N) {
+            throw std::invalid_argument("FixedIntegrator::integrate: input vector y size does not match system dimension.");
+        }
+        State y_fixed = y;
+        integrate(y_fixed, t0, tf);
+        y = y_fixed;
+    }
+
+    void setTransientTime(double t_transient) { t_transient_ = t_transient; }  // Sets transient phase duration (no recording)
+    void setOutputInterval(double interval) { output_interval_ = interval; }   // Sets output sampling interval
+    const Mat& getResults() const { return results_; }                          // Returns matrix of saved results (N × num_samples)
+    const Vec& getTimes() const { return times_; }                              // Returns vector of saved timestamps
+
+private:
+    // One classical RK4 step of size dt_ from (t, y), updating y in place
+    void step(double t, State& y, double dt_half, double dt_sixth) {
+        system_.evalRhs(t, y, k1_);
+        y_temp_ = y + dt_half * k1_;
+        system_.evalRhs(t + dt_half, y_temp_, k2_);
+        y_temp_ = y + dt_half * k2_;
+        system_.evalRhs(t + dt_half, y_temp_, k3_);
+        y_temp_ = y + dt_ * k3_;
+        system_.evalRhs(t + dt_, y_temp_, k4_);
+        y += dt_sixth * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+    }
+
+    System& system_;                   // Reference to the system being integrated
+    double dt_;                        // Integration time step
+
+    double t_transient_ = 0.0;         // Transient integration time
+    double output_interval_ = -1.0;    // Output sampling interval; -1 means no output recording
+    Mat results_;                      // Stores results: (N × num_samples)
+    Vec times_;                        // Stores corresponding times: (num_samples)
+
+    // Fixed-size RK4 stage buffers (no heap storage)
+    State k1_, k2_, k3_, k4_, y_temp_;
+};
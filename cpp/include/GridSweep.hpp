@@ -0,0 +1,103 @@
+#pragma once
+
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+#include "DistributedSweep.hpp"
+#include "ParameterSweep.hpp"
+#include "ResultStore.hpp"
+#include "SweepWorkspace.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// GridSweep class: sweeps several parameters at once, e.g. an omega × gamma regime map.
+//
+// Every axis names a parameter and a range. With Sampling::Grid the points form the full
+// lattice (num_points per axis, the first axis varying fastest); with Sampling::Random and
+// Sampling::Sobol, num_samples points are drawn from the box spanned by the axis ranges
+// (uniform pseudo-random with a seed, or the Sobol low-discrepancy sequence, up to 10 axes).
+//
+// Each processed result is written straight into a ResultStore as soon as its point is done.
+// Pass a spilling store (ResultStore(filename)) to keep memory bounded for large maps and to
+// read completed chunks while the sweep is still running.
+//
+// The same sweep can run across processes: one process calls runCoordinator() and fills the
+// store, any number of worker processes set the sweep up identically and call runWorker()
+// with the same socket path (see DistributedSweep.hpp).
+
+class GridSweep {
+public:
+    using PostProcessFunc = ParameterSweep::PostProcessFunc;
+    using PointFunc = ParameterSweep::PointFunc;
+
+    enum class Sampling {
+        Grid,    // Full lattice of the axis points (default)
+        Random,  // Uniform pseudo-random samples in the parameter box
+        Sobol    // Sobol low-discrepancy samples in the parameter box
+    };
+
+    explicit GridSweep(AbstractDynamicalSystem& system);
+
+    // Adds a swept parameter; num_points only matters for Sampling::Grid
+    void addAxis(const std::string& param_name, double start, double end, int num_points);
+    void setSampling(Sampling sampling, Index num_samples = 0, std::uint64_t seed = 0);
+
+    void setTimeStep(double dt);
+    void setTransientTime(double transient_time);
+    void setOutputInterval(double interval);
+    void setPostProcessingFunction(PostProcessFunc func);
+    void setPointFunction(PointFunc func);  // Takes precedence over the post-processing function
+    void setNumThreads(int num_threads);    // Same semantics as ParameterSweep::setNumThreads
+
+    // Destination of the results; nullptr (default) uses an internal in-memory store.
+    // The store must outlive runSweep() and every read through getResults().
+    void setResultStore(ResultStore* store);
+
+    Mat generatePoints() const;  // Parameter values of all points (num_axes × num_points)
+    void runSweep(const Vec& y0, double t0, double tf);
+    const ResultStore& getResults() const;
+
+    // Distributed execution. The coordinator serves chunks of chunk_points points until all
+    // results are in the store; a worker evaluates chunks (on setNumThreads() threads) until
+    // the coordinator stops it and returns the number of points it evaluated. A chunk outside
+    // the worker's own grid (set up differently from the coordinator's) throws std::runtime_error.
+    SweepCoordinator::Stats runCoordinator(const std::string& socket_path, Index chunk_points = 256,
+                                           double worker_timeout = 0.0);
+    Index runWorker(const std::string& socket_path, const Vec& y0, double t0, double tf);
+
+    // First num_points points of the dims-dimensional Sobol sequence in [0, 1)^dims
+    // (Joe–Kuo direction numbers, the all-zero point skipped)
+    static Mat sobolSequence(Index num_points, int dims);
+
+private:
+    struct Axis {
+        std::string name;
+        double start, end;
+        int num_points;
+    };
+
+    // Integrates one point with the worker's workspace and post-processes the trajectory
+    Vec evaluatePoint(SweepWorkspace& workspace, const std::vector<ParamHandle>& handles,
+                      const Mat& points, Index i, const Vec& y0, double t0, double tf) const;
+    // One workspace per worker on clones of the system, for num_workers > 1
+    std::vector<std::unique_ptr<SweepWorkspace>> makeWorkspaces(
+        int num_workers, std::vector<std::unique_ptr<AbstractDynamicalSystem>>& systems) const;
+
+    AbstractDynamicalSystem& system_;
+    std::vector<Axis> axes_;
+    Sampling sampling_ = Sampling::Grid;
+    Index num_samples_ = 0;
+    std::uint64_t seed_ = 0;
+
+    double transient_time_ = 0.0;
+    double dt_ = Constants::DEFAULT_DT;
+    double output_interval_ = -1.0;  // -1 means no output recording
+    int num_threads_ = 1;
+
+    PostProcessFunc post_process_;
+    PointFunc point_func_;
+    ResultStore* store_ = nullptr;
+    std::unique_ptr<ResultStore> own_store_;  // Used when no store is set
+};
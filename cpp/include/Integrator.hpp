@@ -1,31 +1,134 @@
 #pragma once
 
 #include "AbstractDynamicalSystem.hpp"
+#include "Checkpoint.hpp"
 #include "Definitions.hpp"
+#include "Event.hpp"
+#include "IntegratorStats.hpp"
+#include "TrajectoryIO.hpp"
+#include "TrajectorySink.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
 
-// Integrator class: performs numerical integration using the RK4 method,
+// Integrator class: performs numerical integration using the RK4 method (or a symplectic method, see Method),
 // with support for transient time, controlled output sampling, and result storage.
 
 class Integrator {
 public:
+    // Time-stepping scheme. The symplectic methods need a separable system (hasSplitRhs())
+    // and keep the energy error bounded over arbitrarily long runs instead of drifting;
+    // with them IntegratorStats::rhs_evaluations counts momentumRhs() calls.
+    enum class Method {
+        RK4,             // Classical 4th-order Runge–Kutta (default)
+        VelocityVerlet,  // 2nd-order symplectic, 1 force evaluation per step
+        Yoshida4,        // 4th-order symplectic triple jump of Verlet steps, 3 force evaluations per step
+        Yoshida6         // 6th-order symplectic composition (Yoshida's solution A), 7 force evaluations per step
+    };
+
     Integrator(AbstractDynamicalSystem& system, double dt);  // Constructor with system reference and time step
     void integrate(Vec& y, double t0, double tf);            // Runs integration from t0 to tf
 
     void writeResultsToCSV(const std::string& filename) const;  // Writes the integration results into a CSV file
+    void writeResultsToBinary(const std::string& filename,      // Writes the results in the binary columnar format
+                              const TrajectoryMetadata& metadata = TrajectoryMetadata()) const;
     void setTransientTime(double t_transient);               // Sets transient phase duration (no recording)
     void setOutputInterval(double interval);                 // Sets output sampling interval
+    void setMethod(Method method);                           // Selects the time-stepping scheme (default RK4)
     const Mat& getResults() const;                           // Returns matrix of saved results (dim × num_samples)
     const Vec& getTimes() const;                             // Returns vector of saved timestamps
+    double getFinalTime() const;                             // Time reached by the last integrate()
+    long long getRhsEvaluations() const;                     // Right-hand side calls made by the last integrate()
+    const IntegratorStats& getStats() const;                 // Counters and phase timings of the last integrate()
+
+    // Streams recorded samples to `sink` in chunks of `chunk_size` instead of storing them
+    // in getResults(); peak memory is then one chunk. Pass nullptr to store results again.
+    // The sink must outlive every integrate() call made while it is attached.
+    void setSink(TrajectorySink* sink, int chunk_size = 4096);
+
+    // Registers an event checked after every step of the recording phase; returns its id.
+    // Combined with no output interval, only the event crossings are recorded.
+    int addEvent(const Event& event);
+    void clearEvents();
+    Vec getEventTimes() const;                 // Crossing times of the last integrate(), in order
+    Mat getEventStates() const;                // Crossing states (dim × num_events)
+    const std::vector<int>& getEventIds() const;  // Id of the event behind each crossing
+    bool terminated() const;                   // Whether the last integrate() stopped at a terminal event
+
+    // Writes a checkpoint to `filename` every `every_steps` steps (transient steps included).
+    // Serialisation happens in the step loop; the file is written by a background thread
+    // and replaced atomically. An empty filename disables checkpointing.
+    // Without a sink, samples recorded since the previous checkpoint are appended to
+    // `filename`.samples before each checkpoint; with a sink the current chunk is flushed
+    // first and the sink's saveState() goes into the checkpoint.
+    void setCheckpoint(const std::string& filename, long long every_steps);
+
+    // Continues the integration saved in a checkpoint up to its original tf; y receives the
+    // final state. Time step, transient time, output interval and events must match the
+    // interrupted run. The result is bit-identical to an uninterrupted integrate(). A run
+    // checkpointed with a sink needs a sink that supports resume(); one checkpointed without
+    // a sink reads its samples back from the sample log, delivering them to a sink if attached.
+    void resume(Vec& y, const std::string& filename);
 
 private:
+    // Position within one integrate() call; everything needed to continue it
+    struct Progress {
+        double t0 = 0.0, tf = 0.0, t = 0.0;
+        bool in_transient = true;
+        Index num_samples = 0;      // Planned samples
+        Index sample_idx = 0;       // Samples recorded so far
+        int step_idx = 0;           // Steps taken towards the next sample
+        long long max_steps = 0;    // Main-phase steps left (set when the transient ends)
+    };
+
+    void prepareBuffers();                                    // Checks the method, sizes the stage and event buffers
+    void prepareOutput(const Progress& p);                    // Allocates results or the sink chunk
+    void run(Vec& y, Progress& p);                            // Integrates from the given progress to p.tf
+    bool advance(Progress& p, Vec& y);                        // One step, with events if any; false at a terminal event
+    void checkpointIfDue(const Vec& y, const Progress& p);
+    void writeCheckpoint(const Vec& y, const Progress& p);
+    void step(double t, Vec& y);                              // One step of size dt_, updating y in place
+    void symplecticStep(double t, Vec& y);                    // One step of a Verlet composition method
+    void recordSample(Index sample_idx, double t, const Vec& y);  // Stores a sample or appends it to the chunk
+    void flushChunk();                                        // Hands the filled part of the chunk to the sink
+    bool stepWithEvents(double& t, Vec& y);                   // Steps and records crossings; false at a terminal event
+    void hermite(double theta, const Vec& y_new, Vec& y_out) const;  // Interpolates the last step at fraction theta
+
     AbstractDynamicalSystem& system_;  // Reference to the system being integrated
     double dt_;                        // Integration time step
 
     double t_transient_ = 0.0;         // Transient integration time
     double output_interval_ = -1.0;    // Output sampling interval; -1 means no output recording
+    Method method_ = Method::RK4;      // Time-stepping scheme
     Mat results_;                      // Stores results: (dim × num_samples)
     Vec times_;                        // Stores corresponding times: (num_samples)
+    double t_final_ = 0.0;             // Time reached by the last integrate()
+    IntegratorStats stats_;            // Counters of the last integrate()
+
+    TrajectorySink* sink_ = nullptr;   // Optional streaming output
+    int chunk_size_ = 4096;            // Samples per chunk handed to the sink
+    Mat chunk_states_;                 // Chunk buffer: (dim × chunk_size)
+    Vec chunk_times_;                  // Chunk sample times
+    Index chunk_fill_ = 0;             // Samples currently in the chunk
+
+    std::vector<Event> events_;        // Registered events
+    Vec g_prev_;                       // Switching function values before the current step
+    Vec y_prev_, f_new_;               // Step start state and derivative at the step end
+    Vec y_event_;                      // State at a terminal crossing
+    std::vector<double> event_times_;  // Recorded crossings
+    std::vector<double> event_states_; // Recorded crossing states, dim values per crossing
+    std::vector<int> event_ids_;
+    bool terminated_ = false;
+
+    std::string checkpoint_file_;                // Checkpoint target; empty disables checkpointing
+    long long checkpoint_every_ = 0;             // Steps between checkpoints
+    std::unique_ptr<CheckpointWriter> writer_;   // Background checkpoint writer
+    Index logged_samples_ = 0;                   // Samples already queued for the sample log
+    std::chrono::steady_clock::time_point phase_start_;  // Start of the current phase (for stats)
 
     // Internal RK4 buffers (pre-allocated for performance)
     mutable Vec k1_, k2_, k3_, k4_, y_temp_;
+    // Symplectic buffers: dq/dt and dp/dt (dim / 2); dp_ carries the last force into the next step
+    Vec dq_, dp_;
+    bool force_valid_ = false;         // Whether dp_ holds the force at the current state
 };
\ No newline at end of file
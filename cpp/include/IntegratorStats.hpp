@@ -0,0 +1,30 @@
+#pragma once
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+// IntegratorStats: counters collected by an integrator during its last integrate() call
+struct IntegratorStats {
+    long long rhs_evaluations = 0;       // Right-hand side calls, including event refinement (force calls for symplectic methods)
+    long long steps_taken = 0;           // Accepted steps
+    long long steps_rejected = 0;        // Rejected steps (adaptive integrators only)
+    long long jacobian_evaluations = 0;  // Jacobian evaluations (implicit integrators only)
+    long long factorizations = 0;        // Numeric LU factorizations (implicit integrators only)
+    double transient_seconds = 0.0;      // Wall time spent before the recording phase
+    double recording_seconds = 0.0;      // Wall time spent in the recording phase
+
+    // Single-line JSON object, for tracking performance over time
+    std::string toJSON() const {
+        std::ostringstream out;
+        out << std::setprecision(9)
+            << "{\"rhs_evaluations\":" << rhs_evaluations
+            << ",\"steps_taken\":" << steps_taken
+            << ",\"steps_rejected\":" << steps_rejected
+            << ",\"jacobian_evaluations\":" << jacobian_evaluations
+            << ",\"factorizations\":" << factorizations
+            << ",\"transient_seconds\":" << transient_seconds
+            << ",\"recording_seconds\":" << recording_seconds << "}";
+        return out.str();
+    }
+};
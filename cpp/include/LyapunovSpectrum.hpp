@@ -0,0 +1,41 @@
+#pragma once
+
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+#include "ParameterSweep.hpp"
+
+// LyapunovSpectrum class: computes Lyapunov exponents with the standard (Benettin) method.
+// The system is integrated together with k tangent vectors obeying the variational
+// equations dQ/dt = J(t, y) Q, where J comes from the system's jacobian() hook (analytic
+// or finite-difference). Every reorthonormalization interval the tangent vectors are
+// orthonormalized in place by modified Gram–Schmidt, and the logarithms of their
+// stretching factors are accumulated. Integration uses Integrator (RK4) on the extended
+// (dim + dim * k)-dimensional system.
+
+class LyapunovSpectrum {
+public:
+    LyapunovSpectrum(AbstractDynamicalSystem& system, double dt);  // Constructor with system reference and time step
+
+    void setTransientTime(double t_transient);                // Time until which only the system itself is integrated
+    void setReorthonormalizationInterval(double interval);    // Time between orthonormalizations (default: 1.0)
+    void setNumExponents(int num_exponents);                  // Number of leading exponents; 0 (default) = full spectrum
+
+    // Integrates from t0 to tf, leaves the final state in y and returns the exponents,
+    // ordered from largest to smallest
+    const Vec& compute(Vec& y, double t0, double tf);
+    const Vec& getExponents() const;                          // Exponents of the last compute()
+
+    // Point function for ParameterSweep::setPointFunction() that returns the leading
+    // `num_exponents` exponents of each parameter point
+    static ParameterSweep::PointFunc sweepFunction(double dt, double t_transient,
+                                                   double interval, int num_exponents = 1);
+
+private:
+    AbstractDynamicalSystem& system_;  // Reference to the system being analysed
+    double dt_;                        // Integration time step
+
+    double t_transient_ = 0.0;         // Transient integration time
+    double interval_ = 1.0;            // Reorthonormalization interval
+    int num_exponents_ = 0;            // Requested exponents; 0 means dim
+    Vec exponents_;                    // Result of the last compute()
+};
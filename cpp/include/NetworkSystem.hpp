@@ -0,0 +1,184 @@
+#pragma once
+
+#include "DynamicalSystem.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// NetworkSystem class: N identical copies of a node model coupled through a sparse matrix,
+//
+//     dy_i/dt = f(t, y_i) + coupling * sum_j A_ij y_j[source] e_target,
+//
+// i.e. the 'source' component of every node drives the 'target' component of its
+// neighbours with weights A_ij. Diffusive coupling is obtained by passing the graph
+// Laplacian (A - D) as the coupling matrix.
+//
+// The state is stored node-major (y = [y_0, y_1, ..., y_{N-1}], each y_i contiguous), and
+// the node dynamics are called statically through Node::evalRhs (see FixedIntegrator), with
+// fixed-size segments when NodeDim is given. rhs() runs one fused pass per block of nodes:
+// local dynamics followed by the CSR row products of the same nodes, so every block reads
+// and writes a contiguous slice of y and dydt. Blocks are distributed over a ThreadPool.
+//
+// Parameters: handle 0 is "coupling"; the node's parameters follow, shifted by one, and
+// apply to all nodes.
+
+template <typename Node, int NodeDim = Eigen::Dynamic>
+class NetworkSystem : public DynamicalSystem {
+public:
+    using CouplingMat = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+    static constexpr ParamHandle COUPLING = 0;  // Coupling strength
+    static constexpr Index BLOCK_NODES = 2048;  // Nodes per parallel task
+
+    NetworkSystem(const Node& node, const SparseMat& adjacency, double coupling,
+                  int source = 0, int target = 0)
+        : node_(node), adjacency_(adjacency), source_(source), target_(target) {
+        node_dim_ = node_.dim;
+        num_nodes_ = adjacency_.rows();
+        if (NodeDim != Eigen::Dynamic && node_dim_ != NodeDim) {
+            throw std::invalid_argument("NetworkSystem: node dimension does not match template dimension NodeDim.");
+        }
+        if (adjacency_.rows() != adjacency_.cols() || num_nodes_ == 0) {
+            throw std::invalid_argument("NetworkSystem: coupling matrix must be square and non-empty.");
+        }
+        if (source_ < 0 || source_ >= node_dim_ || target_ < 0 || target_ >= node_dim_) {
+            throw std::invalid_argument("NetworkSystem: coupled components must lie within the node dimension.");
+        }
+        adjacency_.makeCompressed();
+        dim = static_cast<int>(num_nodes_ * node_dim_);
+        defineParameter("coupling", coupling);
+    }
+
+    // Copies share no thread pool; the copy runs single-threaded until setNumThreads()
+    NetworkSystem(const NetworkSystem& other)
+        : DynamicalSystem(other), node_(other.node_), adjacency_(other.adjacency_),
+          node_dim_(other.node_dim_), num_nodes_(other.num_nodes_),
+          source_(other.source_), target_(other.target_) {}
+
+    NetworkSystem& operator=(const NetworkSystem&) = delete;
+
+    // Number of threads used by rhs() (1 runs inline, 0 selects hardware concurrency)
+    void setNumThreads(int num_threads) {
+        if (num_threads == 1) {
+            pool_.reset();
+        } else {
+            pool_ = std::make_unique<ThreadPool>(num_threads);
+            // Built once: a loop body capturing only this fits std::function's inline storage,
+            // so rhs() does not allocate
+            block_body_ = [this](Index b, int) { rhsBlock(call_t_, *call_y_, *call_dydt_, b); };
+        }
+    }
+
+    Index numNodes() const { return num_nodes_; }
+    int nodeDim() const { return node_dim_; }
+    const CouplingMat& adjacency() const { return adjacency_; }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        const Index num_blocks = (num_nodes_ + BLOCK_NODES - 1) / BLOCK_NODES;
+        if (!pool_ || num_blocks == 1) {
+            for (Index b = 0; b < num_blocks; ++b) rhsBlock(t, y, dydt, b);
+        } else {
+            call_t_ = t;
+            call_y_ = &y;
+            call_dydt_ = &dydt;
+            pool_->parallelFor(num_blocks, block_body_);
+        }
+    }
+
+    // Block-diagonal node Jacobians plus the coupling entries; the pattern is fixed
+    void sparseJacobian(double t, const Vec& y, SparseMat& J) override {
+        const double coupling = parameters_[COUPLING];
+        std::vector<Eigen::Triplet<double>> entries;
+        entries.reserve(num_nodes_ * node_dim_ * node_dim_ + adjacency_.nonZeros());
+        Vec y_node(node_dim_);
+        Mat J_node;
+        for (Index i = 0; i < num_nodes_; ++i) {
+            const Index offset = i * node_dim_;
+            y_node = y.segment(offset, node_dim_);
+            node_.jacobian(t, y_node, J_node);
+            for (int r = 0; r < node_dim_; ++r) {
+                for (int c = 0; c < node_dim_; ++c) {
+                    entries.emplace_back(offset + r, offset + c, J_node(r, c));
+                }
+            }
+            for (typename CouplingMat::InnerIterator it(adjacency_, i); it; ++it) {
+                entries.emplace_back(offset + target_, it.col() * node_dim_ + source_, coupling * it.value());
+            }
+        }
+        J.resize(dim, dim);
+        J.setFromTriplets(entries.begin(), entries.end());
+    }
+
+    void jacobian(double t, const Vec& y, Mat& J) override {
+        SparseMat J_sparse;
+        sparseJacobian(t, y, J_sparse);
+        J = Mat(J_sparse);
+    }
+
+    // "coupling" is the network's own parameter; every other name is forwarded to the node
+    ParamHandle getParameterHandle(const std::string& name) const override {
+        if (name == "coupling") return COUPLING;
+        return node_.getParameterHandle(name) + 1;
+    }
+
+    void setParameter(const std::string& name, double value) override {
+        setParameter(getParameterHandle(name), value);
+    }
+
+    double getParameter(const std::string& name) const override {
+        return getParameter(getParameterHandle(name));
+    }
+
+    void setParameter(ParamHandle handle, double value) override {
+        if (handle == COUPLING) {
+            parameters_[COUPLING] = value;
+        } else {
+            node_.setParameter(handle - 1, value);
+        }
+    }
+
+    double getParameter(ParamHandle handle) const override {
+        return (handle == COUPLING) ? parameters_[COUPLING] : node_.getParameter(handle - 1);
+    }
+
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<NetworkSystem>(*this);
+    }
+
+private:
+    // Local dynamics and coupling of the nodes in block b
+    void rhsBlock(double t, const Vec& y, Vec& dydt, Index b) const {
+        const double coupling = parameters_[COUPLING];
+        const Index first = b * BLOCK_NODES;
+        const Index last = std::min(first + BLOCK_NODES, num_nodes_);
+        const double* values = adjacency_.valuePtr();
+        const auto* columns = adjacency_.innerIndexPtr();
+        const auto* rows = adjacency_.outerIndexPtr();
+        for (Index i = first; i < last; ++i) {
+            const Index offset = i * node_dim_;
+            node_.evalRhs(t, y.template segment<NodeDim>(offset, node_dim_),
+                          dydt.template segment<NodeDim>(offset, node_dim_));
+            double sum = 0.0;
+            for (auto k = rows[i]; k < rows[i + 1]; ++k) {
+                sum += values[k] * y[columns[k] * node_dim_ + source_];
+            }
+            dydt[offset + target_] += coupling * sum;
+        }
+    }
+
+    Node node_;                          // Node model shared by all nodes
+    CouplingMat adjacency_;              // Coupling weights A (CSR)
+    int node_dim_ = 0;                   // State variables per node
+    Index num_nodes_ = 0;                // Number of nodes N
+    int source_ = 0;                     // Node component read by the coupling
+    int target_ = 0;                     // Node component driven by the coupling
+    std::unique_ptr<ThreadPool> pool_;   // Workers for rhs(); null runs inline
+    ThreadPool::LoopBody block_body_;    // rhsBlock() on the arguments of the current rhs() call
+    double call_t_ = 0.0;                // Arguments of the current threaded rhs() call
+    const Vec* call_y_ = nullptr;
+    Vec* call_dydt_ = nullptr;
+};
@@ -1,38 +1,186 @@
 #pragma once
 
 #include "AbstractDynamicalSystem.hpp"
+#include "Checkpoint.hpp"
 #include "Integrator.hpp"
+#include "Reducer.hpp"
+#include "SweepWorkspace.hpp"
 #include "Definitions.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 class ParameterSweep {
 public:
     using PostProcessFunc = std::function<Vec(const Mat& result)>;
 
+    // Custom computation of one point, replacing integration + post-processing. It receives
+    // the system with the swept parameter already set (a private clone when threaded).
+    using PointFunc = std::function<Vec(AbstractDynamicalSystem& system, const Vec& y0, double t0, double tf)>;
+
+    // Post-processing of several points in one call. `trajectories` holds the recorded
+    // trajectories of `count` points side by side: dim × (num_samples · count), point j in
+    // columns [j · num_samples, (j + 1) · num_samples). Returns result_dim × count.
+    using BatchPostProcessFunc = std::function<Mat(const Mat& trajectories, Index count)>;
+
+    // Integration backend of runSweep()
+    enum class Backend {
+        Scalar,    // One Integrator per parameter point
+        Ensemble   // Blocks of points integrated together by EnsembleIntegrator (requires rhsBatch())
+    };
+
+    // Point order and seeding of runSweep()
+    enum class Continuation {
+        Off,       // Every point starts from y0 and integrates the full transient (default)
+        Forward,   // Increasing parameter order, each point seeded from the previous final state
+        Backward,  // Decreasing parameter order, seeded likewise
+        Both       // Forward into getProcessedResults(), backward into getBackwardResults()
+    };
+
+    // Statistics of the last runSweep() or resumeSweep()
+    struct SweepStats {
+        Index points = 0;                     // Points evaluated (both directions counted)
+        Index warm_started = 0;               // Points seeded from a neighbour's final state
+        Index converged_early = 0;            // Warm-started points whose transient was cut short
+        double transient_time_nominal = 0.0;  // Transient time without continuation
+        double transient_time_used = 0.0;     // Transient time actually integrated
+        double seconds = 0.0;                 // Wall time
+
+        // Fraction of the nominal transient time that was skipped
+        double transientSavings() const {
+            return transient_time_nominal > 0.0 ? 1.0 - transient_time_used / transient_time_nominal : 0.0;
+        }
+    };
+
     ParameterSweep(AbstractDynamicalSystem& system, const std::string& param_name);
 
     void setParameterRange(double start, double end, int num_steps);
     void setTimeStep(double dt);
     void setTransientTime(double transient_time);
+    void setOutputInterval(double interval);  // Sampling interval of the trajectory passed to post-processing
     void setPostProcessingFunction(PostProcessFunc func);
+    void setPointFunction(PointFunc func);     // Takes precedence over the post-processing function
+
+    // Post-processes the points in batches of up to batch_size, in sweep order, instead of one
+    // by one; takes precedence over setPostProcessingFunction(). The function is always called
+    // on the thread running the sweep, so it need not be thread-safe (integration still uses
+    // setNumThreads() workers). Requires the scalar backend without continuation.
+    void setBatchPostProcessingFunction(BatchPostProcessFunc func, Index batch_size = 256);
+
+    // Folds every point's recorded samples into a copy of `reducer` while integrating and
+    // stores its result(), instead of post-processing the full trajectory: each worker holds
+    // one reducer and a sink chunk of `chunk_size` samples, whatever the trajectory length.
+    // Takes precedence over setPostProcessingFunction(); the point and batch functions take
+    // precedence over it. Requires the scalar backend without continuation.
+    void setReducer(const Reducer& reducer, int chunk_size = 256);
+
+    // Number of worker threads for runSweep(). 1 (default) integrates every point on the
+    // shared system; 0 uses all hardware threads. With more than one thread each worker
+    // integrates its own clone() of the system, and the post-processing function is called
+    // concurrently, so it must be thread-safe. Results do not depend on the thread count.
+    void setNumThreads(int num_threads);
+
+    // Selects the integration backend. With Backend::Ensemble the points are integrated in
+    // blocks of at most block_size members, each block on one worker thread.
+    void setBackend(Backend backend, Index block_size = 1024);
+
+    // Enables continuation sweeps. Points are integrated one after another, each seeded from
+    // the final state of its neighbour; the first point of a direction starts cold from y0.
+    // Warm-started points integrate their transient in windows of length `window` (0: a
+    // fiftieth of the transient) and stop once the per-component min/max envelopes of two
+    // consecutive windows agree within `tolerance` (relative to the envelope magnitude, at
+    // least 1). The transient time stays the upper bound, and the recorded phase keeps its
+    // length but is shifted to start where the transient ended. Requires the scalar backend
+    // and a post-processing function; with Both and more than one thread the two directions
+    // run concurrently. Continuation sweeps cannot be checkpointed.
+    void setContinuation(Continuation mode, double tolerance = 1e-4, double window = 0.0);
+
+    // Saves the sweep progress (completed points and their results) to `filename` after
+    // every `every_points` completed points and at the end of the sweep. Files are written
+    // by a background thread and replaced atomically. An empty filename disables it.
+    // Workers only record completed points under a lock; the checkpoint is built outside
+    // it, so a small interval costs serialisation work but does not serialise the workers.
+    void setCheckpoint(const std::string& filename, int every_points = 64);
 
     void runSweep(const Vec& y0, double t0, double tf);
+
+    // Continues a sweep from the checkpoint file set by setCheckpoint(): completed points are
+    // loaded and only the remaining ones are evaluated. Parameter values, integration settings
+    // and backend must match the interrupted sweep.
+    void resumeSweep(const Vec& y0, double t0, double tf);
     const std::vector<double>& getParameterValues() const;
     const Mat& getProcessedResults() const;
+    const Mat& getBackwardResults() const;  // Backward-direction results of Continuation::Both
+    const SweepStats& getStats() const;
 
     // Save parameter values and processed results to CSV
     void writeResultsToCSV(const std::string& filename) const;
+    // Save parameter values (abscissa) and processed results in the binary columnar format
+    void writeResultsToBinary(const std::string& filename) const;
 
 private:
+    // Integrates one parameter point with the worker's workspace and post-processes the trajectory
+    Vec evaluatePoint(SweepWorkspace& workspace, ParamHandle param, double param_value,
+                      const Vec& y0, double t0, double tf) const;
+    // Evaluates every point not yet marked done, with the selected backend
+    void runPending(const Vec& y0, double t0, double tf);
+    // New workspace on `system`, with a copy of the reducer attached when one is used
+    std::unique_ptr<SweepWorkspace> makeWorkspace(AbstractDynamicalSystem& system) const;
+    // Scalar backend
+    void runScalarSweep(const Vec& y0, double t0, double tf);
+    // Scalar backend with batched post-processing
+    void runBatchedSweep(const std::vector<Index>& pending, const Vec& y0, double t0, double tf);
+    // Ensemble backend
+    void runEnsembleSweep(const Vec& y0, double t0, double tf);
+    // Continuation backend
+    void runContinuationSweep(const Vec& y0, double t0, double tf);
+    // One continuation pass over all points in the given direction
+    void continuationPass(AbstractDynamicalSystem& system, bool backward, const Vec& y0,
+                          double t0, double tf, Mat& results, SweepStats& stats) const;
+    // Transient of a warm-started point with the envelope convergence check, run on the
+    // pass's window integrator; returns the time integrated and advances t and y
+    double warmTransient(Integrator& integrator, Vec& y, double& t, double nominal,
+                         bool& converged) const;
+    // Stores the result of point i, marks it done and checkpoints when due (thread-safe)
+    void store(Index i, const Vec& processed);
+    // Adds the given completed points to the checkpoint state, serialises it and hands it
+    // to the background writer (thread-safe)
+    void saveCheckpoint(const std::vector<Index>& points);
+
     AbstractDynamicalSystem& system_;
     std::string param_name_;
     std::vector<double> param_values_;
     double transient_time_ = 0.0;
     double dt_ = Constants::DEFAULT_DT;  // Default time step from Definitions.hpp
+    double output_interval_ = -1.0;      // -1 means no output recording
+    int num_threads_ = 1;
+    Backend backend_ = Backend::Scalar;
+    Index block_size_ = 1024;
 
     PostProcessFunc post_process_;
+    PointFunc point_func_;
+    BatchPostProcessFunc batch_post_process_;
+    Index batch_size_ = 256;
+    std::unique_ptr<Reducer> reducer_;
+    int reducer_chunk_ = 256;
     Mat processed_results_;  // Each column: processed result for each parameter
+    Mat backward_results_;   // Backward pass of Continuation::Both, same column order
+    SweepStats stats_;
+    Continuation continuation_ = Continuation::Off;
+    double continuation_tol_ = 1e-4;
+    double continuation_window_ = 0.0;
+    std::vector<std::uint8_t> done_;  // Whether each point has been evaluated
+
+    std::string checkpoint_file_;               // Checkpoint target; empty disables checkpointing
+    int checkpoint_every_ = 0;                  // Completed points between checkpoints
+    std::unique_ptr<CheckpointWriter> writer_;  // Background checkpoint writer
+    std::vector<Index> fresh_points_;           // Points completed since the last checkpoint
+    std::mutex progress_mutex_;                 // Guards fresh_points_
+    Mat saved_results_;                         // Results of the points in the last checkpoint
+    std::vector<std::uint8_t> saved_done_;      // Points in the last checkpoint
+    std::mutex checkpoint_mutex_;               // Guards saved_results_ and saved_done_
 };
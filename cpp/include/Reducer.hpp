@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "TrajectorySink.hpp"
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+// Reducer: an online statistic folded over the recorded samples of a trajectory as the
+// integrator produces them, so no trajectory buffer is needed. Reducers are TrajectorySinks:
+// attach one to Integrator::setSink(), or hand one to ParameterSweep::setReducer() to get
+// result() as the processed result of every point. begin() resets the state, so one reducer
+// can be reused across integrations; in checkpointed runs the state is saved with every
+// checkpoint and restored by resume().
+//
+// Whole-state reducers (min/max, mean/variance) work on full chunks with Eigen expressions;
+// the others follow a single state component. Combine several with ReducerSet.
+
+class Reducer : public TrajectorySink {
+public:
+    void begin(int dim) override;
+    void resume(int dim, Index samples, CheckpointData& state) override;  // Restores the saved statistic
+    virtual Vec result() const = 0;                      // Statistic of the samples seen so far
+    virtual std::unique_ptr<Reducer> clone() const = 0;  // Fresh copy with the same settings
+
+protected:
+    virtual void reset(int dim) = 0;
+    virtual void loadState(CheckpointData& state) = 0;  // Reads what saveState() wrote
+};
+
+// Per-component extremes: [min_0 .. min_{dim-1}, max_0 .. max_{dim-1}]
+class MinMaxReducer : public Reducer {
+public:
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    Vec min_, max_;
+};
+
+// Per-component mean and population variance: [mean_0 .. mean_{dim-1}, var_0 .. var_{dim-1}].
+// Chunk statistics are merged with Chan's parallel update, which stays accurate for long runs.
+class MeanVarianceReducer : public Reducer {
+public:
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    Index count_ = 0;
+    Vec mean_, m2_;  // Running mean and sum of squared deviations
+};
+
+// Local maxima of one component (a sample above its predecessor and not below its successor):
+// [number of peaks, mean, min, max of the peak values]; the statistics are NaN without peaks
+class PeakReducer : public Reducer {
+public:
+    explicit PeakReducer(int component);
+
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    int component_;
+    Index seen_ = 0;           // Samples seen (only the last two are kept)
+    double prev2_ = 0.0, prev1_ = 0.0;
+    Index peaks_ = 0;
+    double sum_ = 0.0, min_ = 0.0, max_ = 0.0;
+};
+
+// Period of one component from its upward crossings of `level`, located by linear
+// interpolation between samples: [mean period, standard deviation of the periods, number of
+// crossings]; the period is NaN with fewer than two crossings
+class PeriodReducer : public Reducer {
+public:
+    explicit PeriodReducer(int component, double level = 0.0);
+
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    int component_;
+    double level_;
+    bool has_prev_ = false;
+    double prev_value_ = 0.0, prev_time_ = 0.0;
+    Index crossings_ = 0;
+    double last_crossing_ = 0.0;
+    double mean_period_ = 0.0, m2_period_ = 0.0;  // Welford statistics of the intervals
+};
+
+// Histogram of one component over [lo, hi) with equal-width bins: the sample count of every
+// bin. Samples outside the range are not counted.
+class HistogramReducer : public Reducer {
+public:
+    HistogramReducer(int component, double lo, double hi, int bins);
+
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    int component_;
+    double lo_, hi_;
+    Vec counts_;
+};
+
+// Spectral power of one component at chosen frequencies (cycles per time unit), accumulated
+// as a running DFT: [P(f_0) .. P(f_{n-1})] with P = |2 X(f) / N|^2, so a sinusoid of
+// amplitude A at a bin frequency gives A^2. All frequencies advance together by one complex
+// rotation per sample (samples are assumed evenly spaced, as recorded by Integrator); the
+// phase is recomputed exactly at the start of every chunk.
+class SpectralReducer : public Reducer {
+public:
+    SpectralReducer(int component, const std::vector<double>& frequencies);
+
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    using CArr = Eigen::ArrayXcd;
+
+    int component_;
+    Arr frequencies_;
+    Index count_ = 0;
+    CArr sums_;              // Running DFT sums
+    CArr phasors_, steps_;   // Per-frequency e^{-2 pi i f t} and its per-sample rotation
+};
+
+// Several reducers fed from the same samples; result() concatenates their results in the
+// order they were added
+class ReducerSet : public Reducer {
+public:
+    ReducerSet() = default;
+    ReducerSet(const ReducerSet& other);
+    ReducerSet& operator=(const ReducerSet& other);
+
+    ReducerSet& add(const Reducer& reducer);  // Adds a copy
+
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void end() override;
+    void saveState(CheckpointData& state) const override;
+    void resume(int dim, Index samples, CheckpointData& state) override;
+    Vec result() const override;
+    std::unique_ptr<Reducer> clone() const override;
+
+protected:
+    void reset(int dim) override;
+    void loadState(CheckpointData& state) override;
+
+private:
+    std::vector<std::unique_ptr<Reducer>> reducers_;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ResultStore class: preallocated, chunked storage for the processed results of a sweep.
+// Results are grouped into chunks of consecutive points. The in-memory store keeps one
+// result_dim × num_points matrix. The spilling store (constructed with a filename) keeps
+// only chunks that are still being filled: once all points of a chunk arrived it is written
+// to the file and its buffer is released, so memory stays bounded by the chunks in flight
+// (about two per worker thread).
+//
+// Store file layout (native-endian):
+//
+//   header       magic "NLDKRES\0", uint32 version, uint32 header size, uint64 result_dim,
+//                uint64 num_points, uint64 chunk_points, uint64 num_axes, axis names,
+//                padded to 64 bytes
+//   flags        one byte per chunk, set to 1 once all its points are written (64-byte padded)
+//   coordinates  num_axes × num_points doubles, column-major (64-byte padded)
+//   data         per chunk: result_dim × chunk_points doubles, column-major
+//
+// Completion flags make a running sweep readable: open() the file from another process or
+// thread and read every chunk for which isChunkComplete() holds.
+
+class ResultStore {
+public:
+    ResultStore();                                                                 // In-memory store
+    explicit ResultStore(const std::string& filename, Index chunk_points = 4096);  // Spilling store
+    ~ResultStore();
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    // Read-only view of a store file, which may still be written by a running sweep
+    static std::unique_ptr<ResultStore> open(const std::string& filename);
+
+    // Writing, called by the sweep: begin() once the result size is known, then store()
+    // for every point (thread-safe), then end()
+    void begin(Index result_dim, const Mat& coordinates, const std::vector<std::string>& axis_names);
+    void store(Index point, const Vec& result);
+    // Writes the stored points of chunks left incomplete (e.g. by a failed sweep), with NaN in
+    // the missing columns; their completion flag stays 0, so readers still see them as incomplete
+    void end();
+
+    Index resultDim() const;
+    Index numPoints() const;
+    Index chunkPoints() const;
+    Index numChunks() const;
+    const std::vector<std::string>& axisNames() const;
+    const Mat& coordinates() const;  // Parameter values of every point (num_axes × num_points)
+
+    bool isChunkComplete(Index chunk) const;
+    Mat readChunk(Index chunk) const;              // result_dim × points of the chunk; throws if incomplete
+    Mat readPoints(Index first, Index count) const;  // Any range of completed points
+    Mat readAll() const;
+
+private:
+    enum class Mode { Memory, Spill, Read };
+
+    void writeChunk(Index chunk, bool complete);  // Writes a chunk buffer to the file; sets its flag if complete
+    std::uint8_t readFlag(Index chunk) const;
+
+    Mode mode_;
+    std::string filename_;
+    int fd_ = -1;
+    Index chunk_points_ = 4096;
+    Index result_dim_ = 0;
+    Index num_points_ = 0;
+    std::vector<std::string> axis_names_;
+    Mat coordinates_;
+
+    std::uint64_t flags_offset_ = 0;                // File offsets of the sections
+    std::uint64_t data_offset_ = 0;
+
+    Mat results_;                                   // In-memory mode: all results
+    std::vector<Mat> chunk_buffers_;                // Spill mode: chunks being filled
+    std::vector<Index> chunk_fill_;                 // Points stored per chunk
+    mutable std::mutex mutex_;
+};
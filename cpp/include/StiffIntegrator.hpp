@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <Eigen/SparseLU>
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+#include "IntegratorStats.hpp"
+
+// StiffIntegrator class: linearly implicit integration for stiff systems using the
+// two-stage, second-order Rosenbrock-W method ROS2 (Verwer et al., gamma = 1 + 1/sqrt(2))
+// with an embedded first-order error estimate and adaptive step size.
+//
+// Each step solves two linear systems with W = I - gamma * h * J, where J comes from the
+// system's sparseJacobian() hook. Being a W-method, ROS2 keeps its order with an outdated
+// Jacobian, so J and the sparse LU factorisation of W are reused across steps:
+//   - the symbolic analysis (ordering) of W is computed once and redone only if the
+//     sparsity pattern of the Jacobian changes,
+//   - J is re-evaluated only after a rejected step (the error control degrades),
+//   - W is refactorised only when J or h changes; small step size increases (up to 20%)
+//     are skipped to keep the current factorisation.
+//
+// The sample grid matches AdaptiveIntegrator: samples at t_rec + k * interval, filled by
+// cubic Hermite interpolation of each accepted step.
+
+class StiffIntegrator {
+public:
+    StiffIntegrator(AbstractDynamicalSystem& system, double initial_dt);  // Constructor with system reference and first trial step
+    void integrate(Vec& y, double t0, double tf);                         // Runs integration from t0 to tf
+
+    void writeResultsToCSV(const std::string& filename) const;  // Writes the integration results into a CSV file
+    void setTransientTime(double t_transient);               // Sets transient phase duration (no recording)
+    void setOutputInterval(double interval);                 // Sets output sampling interval
+    void setTolerances(double rel_tol, double abs_tol);      // Sets relative and absolute local error tolerances
+    void setMaxStep(double max_dt);                          // Limits the step size (default: unlimited)
+    const Mat& getResults() const;                           // Returns matrix of saved results (dim × num_samples)
+    const Vec& getTimes() const;                             // Returns vector of saved timestamps
+    const IntegratorStats& getStats() const;                 // Counters and phase timings of the last integrate()
+
+private:
+    void updateJacobian(double t, const Vec& y);  // Evaluates J and re-analyses W if the pattern changed
+    void factorize(double h);                     // Builds W = I - gamma * h * J and factorises it
+
+    AbstractDynamicalSystem& system_;  // Reference to the system being integrated
+    double initial_dt_;                // First trial step size
+
+    double t_transient_ = 0.0;         // Transient integration time
+    double output_interval_ = -1.0;    // Output sampling interval; -1 means no output recording
+    double rel_tol_ = 1e-6;            // Relative local error tolerance
+    double abs_tol_ = 1e-9;            // Absolute local error tolerance
+    double max_dt_ = 0.0;              // Maximum step size; 0 means unlimited
+    Mat results_;                      // Stores results: (dim × num_samples)
+    Vec times_;                        // Stores corresponding times: (num_samples)
+
+    IntegratorStats stats_;            // Counters of the last integrate()
+
+    // Linear algebra state, kept between integrate() calls
+    SparseMat J_;                                               // Current Jacobian approximation
+    SparseMat W_;                                               // Iteration matrix I - gamma * h * J
+    SparseMat identity_;                                        // Sparse identity (dim × dim)
+    Eigen::SparseLU<SparseMat, Eigen::COLAMDOrdering<int>> lu_; // Factorisation of W
+    std::vector<SparseMat::StorageIndex> pattern_outer_;        // Pattern the LU analysis was made for
+    std::vector<SparseMat::StorageIndex> pattern_inner_;
+    bool analyzed_ = false;                                     // Whether lu_ holds a valid symbolic analysis
+
+    // Internal stage buffers (pre-allocated for performance)
+    Vec f0_, f1_, k1_, k2_, y_new_, y_temp_;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "Reducer.hpp"
+
+#include <memory>
+
+// Per-worker scratch of a sweep, reused for every point the worker evaluates. The
+// integrator keeps its stage buffers and result matrix between integrate() calls, and the
+// state buffer keeps its storage, so after a worker's first point the integration itself
+// allocates nothing.
+struct SweepWorkspace {
+    SweepWorkspace(AbstractDynamicalSystem& system, double dt, double transient_time, double output_interval)
+        : system(system), integrator(system, dt), y(system.dim) {
+        integrator.setTransientTime(transient_time);
+        integrator.setOutputInterval(output_interval);
+    }
+
+    // Integrates from y0 on the workspace system and returns the recorded trajectory
+    const Mat& integrate(const Vec& y0, double t0, double tf) {
+        y = y0;  // Same size: copies into the existing storage
+        integrator.integrate(y, t0, tf);
+        return integrator.getResults();
+    }
+
+    // Streams the recorded samples of every later integration into `reducer` in chunks of
+    // `chunk_size` instead of storing them; the trajectory is then never held in memory
+    void setReducer(std::unique_ptr<Reducer> r, int chunk_size = 256) {
+        reducer = std::move(r);
+        integrator.setSink(reducer.get(), chunk_size);
+    }
+
+    // Integrates from y0 through the reducer and returns its result
+    Vec reduce(const Vec& y0, double t0, double tf) {
+        y = y0;
+        integrator.integrate(y, t0, tf);
+        return reducer->result();
+    }
+
+    AbstractDynamicalSystem& system;
+    Integrator integrator;
+    Vec y;  // State buffer
+    std::unique_ptr<Reducer> reducer;  // Optional streaming post-processing
+};
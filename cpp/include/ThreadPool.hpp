@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool class: a fixed set of persistent worker threads that execute
+// parallel loops with a work-stealing scheduler.
+//
+// Each parallelFor() splits the index range into one contiguous block per worker.
+// Workers consume their own block front to back; a worker that runs dry steals
+// the back half of the largest remaining block of another worker. The calling
+// thread takes part as worker 0, so a pool of size 1 runs the loop inline.
+
+class ThreadPool {
+public:
+    using LoopBody = std::function<void(Index i, int worker)>;
+
+    explicit ThreadPool(int num_threads = 0);  // 0 selects std::thread::hardware_concurrency()
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const;  // Number of workers, including the calling thread
+
+    // Runs body(i, worker) for every i in [0, n) and blocks until all iterations finished.
+    // 'worker' is in [0, size()) and identifies the executing thread, so callers can keep
+    // per-worker state without locking. The first exception thrown by body is rethrown here.
+    // Not reentrant: only one parallelFor may be active on a pool at a time.
+    void parallelFor(Index n, const LoopBody& body);
+
+private:
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        Index begin = 0;
+        Index end = 0;
+    };
+
+    void workerLoop(int worker);
+    void runWorker(int worker);
+    bool nextIndex(int worker, Index& i);  // Pops from the own queue, otherwise steals
+
+    int num_threads_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const LoopBody* body_ = nullptr;
+    std::uint64_t generation_ = 0;  // Incremented for each parallelFor to wake the workers
+    int active_ = 0;                // Helper threads still working on the current loop
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Binary columnar trajectory format (.nldk)
+//
+//   header   magic "NLDKTRJ\0", uint32 version, uint32 header size, uint64 dim,
+//            uint64 num_samples, abscissa name, named double metadata
+//   padding  to a 64-byte boundary
+//   data     abscissa[num_samples], column_0[num_samples], ..., column_{dim-1}[num_samples]
+//
+// All values are native-endian doubles. Each state component is one contiguous column,
+// so a reader can map the file and view columns without copying or parsing.
+
+struct TrajectoryMetadata {
+    std::string abscissa_name = "time";        // Meaning of the abscissa column (time or swept parameter)
+    std::map<std::string, double> values;      // Named scalars, e.g. dt or system parameters
+};
+
+// Writes `times` and the columns of `states` (dim × num_samples, as returned by getResults())
+// with large buffered writes. Throws std::runtime_error on I/O failure.
+void writeTrajectoryBinary(const std::string& filename, const Vec& times, const Mat& states,
+                           const TrajectoryMetadata& metadata = TrajectoryMetadata());
+
+// Writes `times` and `states` as CSV: a "time,state_0,...,state_{dim-1}" header and one
+// row per sample in full precision. Throws std::runtime_error if the file cannot be opened.
+void writeTrajectoryCSV(const std::string& filename, const Vec& times, const Mat& states);
+
+// Read-only, memory-mapped view of a binary trajectory file. The returned maps point
+// directly into the mapping and stay valid as long as this object is alive.
+class MappedTrajectory {
+public:
+    explicit MappedTrajectory(const std::string& filename);
+    ~MappedTrajectory();
+
+    MappedTrajectory(const MappedTrajectory&) = delete;
+    MappedTrajectory& operator=(const MappedTrajectory&) = delete;
+    MappedTrajectory(MappedTrajectory&& other) noexcept;
+    MappedTrajectory& operator=(MappedTrajectory&& other) noexcept;
+
+    Index dim() const;
+    Index numSamples() const;
+    const TrajectoryMetadata& metadata() const;
+
+    Eigen::Map<const Vec> times() const;           // Abscissa column (num_samples)
+    Eigen::Map<const Mat> columns() const;         // All state columns (num_samples × dim)
+    Eigen::Map<const Vec> column(Index i) const;   // One state component (num_samples)
+
+private:
+    void unmap();
+
+    void* mapping_ = nullptr;
+    std::size_t mapped_bytes_ = 0;
+    const double* data_ = nullptr;  // Start of the abscissa column
+    Index dim_ = 0;
+    Index num_samples_ = 0;
+    TrajectoryMetadata metadata_;
+};
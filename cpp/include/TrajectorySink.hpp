@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <fstream>
+#include <functional>
+#include <string>
+
+// TrajectorySink: receives recorded samples from an integrator in fixed-size chunks while
+// the integration is running, so the trajectory never has to be held in memory as a whole.
+// A chunk is a dim × n block of states together with its n sample times; the views are
+// only valid during the consume() call.
+//
+// Checkpointed runs: every Integrator checkpoint first delivers the pending chunk and then
+// stores saveState() in the checkpoint. Integrator::resume() calls resume() instead of
+// begin(), with the number of samples delivered up to that checkpoint and the saved state;
+// the sink continues from there and drops whatever it received after the checkpoint.
+
+class CheckpointData;
+
+class TrajectorySink {
+public:
+    virtual ~TrajectorySink() = default;
+
+    virtual void begin(int dim) {}  // Called once before the first chunk of an integration
+    virtual void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) = 0;
+    virtual void end() {}           // Called once after the last chunk has been delivered
+
+    virtual void saveState(CheckpointData& state) const {}  // Default: nothing to save
+    // Default: throws std::runtime_error, the sink cannot continue an interrupted run
+    virtual void resume(int dim, Index samples, CheckpointData& state);
+};
+
+// Writes the samples to a CSV file in the same layout as Integrator::writeResultsToCSV
+class CSVFileSink : public TrajectorySink {
+public:
+    explicit CSVFileSink(const std::string& filename);
+
+    void begin(int dim) override;
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void end() override;
+    void saveState(CheckpointData& state) const override;                // Bytes written so far
+    void resume(int dim, Index samples, CheckpointData& state) override;  // Truncates to them and appends
+
+private:
+    void setFormat();
+
+    std::string filename_;
+    mutable std::ofstream file_;  // Flushed by saveState()
+};
+
+// Keeps only the last `capacity` samples in a circular buffer
+class RingBufferSink : public TrajectorySink {
+public:
+    explicit RingBufferSink(Index capacity);
+
+    void begin(int dim) override;
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void saveState(CheckpointData& state) const override;
+    void resume(int dim, Index samples, CheckpointData& state) override;
+
+    Index size() const;   // Number of samples currently held (at most capacity)
+    Mat getResults() const;  // Held samples in chronological order (dim × size)
+    Vec getTimes() const;    // Corresponding sample times
+
+private:
+    Index capacity_;
+    Index next_ = 0;     // Column that receives the next sample
+    Index count_ = 0;    // Samples held
+    Mat states_;
+    Vec times_;
+};
+
+// Forwards every chunk to a user function, e.g. to fold running statistics. On resume the
+// function only receives the samples after the checkpoint.
+class CallbackSink : public TrajectorySink {
+public:
+    using ChunkFunc = std::function<void(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times)>;
+
+    explicit CallbackSink(ChunkFunc func);
+
+    void consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) override;
+    void resume(int dim, Index samples, CheckpointData& state) override;
+
+private:
+    ChunkFunc func_;
+};
@@ -4,33 +4,84 @@
 
 // Class representing a damped harmonic oscillator system
 class DampedOscillator : public DynamicalSystem {
-    double omega_;  // Natural frequency
-    double gamma_;  // Damping coefficient
+    Arr omega_batch_;  // Per-member natural frequencies for rhsBatch()
+    Arr gamma_batch_;  // Per-member damping coefficients for rhsBatch()
 
 public:
+    // Parameter handles, in declaration order
+    static constexpr ParamHandle OMEGA = 0;  // Natural frequency
+    static constexpr ParamHandle GAMMA = 1;  // Damping coefficient
+
     // Constructor initializes system dimension and parameters
     DampedOscillator(double omega, double gamma) {
         dim = 2;
-        setParameter("omega", omega);
-        setParameter("gamma", gamma);
+        defineParameter("omega", omega);
+        defineParameter("gamma", gamma);
     }
 
-    // Compute the right-hand side of the ODE
+    // Compute the right-hand side of the ODE (dydt arrives sized, nothing is allocated)
     void rhs(double t, const Vec& y, Vec& dydt) override {
-        dydt.resize(2);
+        evalRhs(t, y, dydt);
+    }
+
+    // Statically dispatched right-hand side for any Eigen vector type
+    // (used by FixedIntegrator with fixed-size vectors)
+    template <typename StateIn, typename StateOut>
+    void evalRhs(double t, const StateIn& y, StateOut&& dydt) const {
+        const double omega = parameters_[OMEGA];
+        const double gamma = parameters_[GAMMA];
         dydt[0] = y[1];
-        dydt[1] = -2.0 * gamma_ * y[1] - omega_ * omega_ * y[0];
+        dydt[1] = -2.0 * gamma * y[1] - omega * omega * y[0];
+    }
+
+    // Analytic Jacobian of the linear right-hand side
+    void jacobian(double t, const Vec& y, Mat& J) override {
+        const double omega = parameters_[OMEGA];
+        J.resize(2, 2);
+        J << 0.0, 1.0,
+             -omega * omega, -2.0 * parameters_[GAMMA];
+    }
+
+    bool hasBatchRhs() const override {
+        return true;
     }
 
-    // Set parameter by name and update cached variables
-    void setParameter(const std::string& name, double value) override {
-        DynamicalSystem::setParameter(name, value);
-        if (name == "omega") {
-            omega_ = value;
-        } else if (name == "gamma") {
-            gamma_ = value;
+    // Vectorized right-hand side over all ensemble members. Per-member parameters set by
+    // setParameterBatch() are used when their size matches the ensemble, scalars otherwise.
+    void rhsBatch(double t, const BatchMat& Y, BatchMat& dYdt) override {
+        const Index n = Y.cols();
+        const double omega = parameters_[OMEGA];
+        const double gamma = parameters_[GAMMA];
+        dYdt.resize(2, n);
+        dYdt.row(0) = Y.row(1);
+        if (omega_batch_.size() == n && gamma_batch_.size() == n) {
+            dYdt.row(1).array() = -2.0 * gamma_batch_.transpose() * Y.row(1).array()
+                                - omega_batch_.square().transpose() * Y.row(0).array();
+        } else if (omega_batch_.size() == n) {
+            dYdt.row(1).array() = -2.0 * gamma * Y.row(1).array()
+                                - omega_batch_.square().transpose() * Y.row(0).array();
+        } else if (gamma_batch_.size() == n) {
+            dYdt.row(1).array() = -2.0 * gamma_batch_.transpose() * Y.row(1).array()
+                                - omega * omega * Y.row(0).array();
         } else {
-            throw std::invalid_argument("Unknown parameter: " + name);
+            dYdt.row(1).array() = -2.0 * gamma * Y.row(1).array() - omega * omega * Y.row(0).array();
         }
     }
+
+    // Set per-member parameter values for rhsBatch(); an empty array clears them
+    void setParameterBatch(const std::string& name, const Arr& values) override {
+        const ParamHandle param = getParameterHandle(name);
+        if (param == OMEGA) {
+            omega_batch_ = values;
+        } else if (param == GAMMA) {
+            gamma_batch_ = values;
+        } else {
+            throw std::invalid_argument("DampedOscillator::setParameterBatch: unknown parameter " + name + ".");
+        }
+    }
+
+    // Copy the oscillator together with its current parameters
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<DampedOscillator>(*this);
+    }
 };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "DynamicalSystem.hpp"
+
+// Class representing the Lorenz system (chaotic for sigma = 10, rho = 28, beta = 8/3)
+class Lorenz : public DynamicalSystem {
+public:
+    // Parameter handles, in declaration order
+    static constexpr ParamHandle SIGMA = 0;
+    static constexpr ParamHandle RHO = 1;
+    static constexpr ParamHandle BETA = 2;
+
+    // Constructor initializes system dimension and parameters
+    Lorenz(double sigma = 10.0, double rho = 28.0, double beta = 8.0 / 3.0) {
+        dim = 3;
+        defineParameter("sigma", sigma);
+        defineParameter("rho", rho);
+        defineParameter("beta", beta);
+    }
+
+    // Compute the right-hand side of the ODE (dydt arrives sized, nothing is allocated)
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        evalRhs(t, y, dydt);
+    }
+
+    // Statically dispatched right-hand side for any Eigen vector type
+    template <typename StateIn, typename StateOut>
+    void evalRhs(double t, const StateIn& y, StateOut&& dydt) const {
+        dydt[0] = parameters_[SIGMA] * (y[1] - y[0]);
+        dydt[1] = y[0] * (parameters_[RHO] - y[2]) - y[1];
+        dydt[2] = y[0] * y[1] - parameters_[BETA] * y[2];
+    }
+
+    // Analytic Jacobian
+    void jacobian(double t, const Vec& y, Mat& J) override {
+        const double sigma = parameters_[SIGMA];
+        J.resize(3, 3);
+        J << -sigma, sigma, 0.0,
+             parameters_[RHO] - y[2], -1.0, -y[0],
+             y[1], y[0], -parameters_[BETA];
+    }
+
+    // Copy the system together with its current parameters
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<Lorenz>(*this);
+    }
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "DynamicalSystem.hpp"
+#include <cmath>
+
+// Class representing the undamped pendulum theta'' = -omega^2 sin(theta), written as the
+// separable Hamiltonian H = p^2 / 2 - omega^2 cos(theta) with state y = [theta; p]
+class Pendulum : public DynamicalSystem {
+public:
+    // Parameter handles, in declaration order
+    static constexpr ParamHandle OMEGA = 0;  // Small-amplitude angular frequency
+
+    // Constructor initializes system dimension and parameters
+    explicit Pendulum(double omega = 1.0) {
+        dim = 2;
+        defineParameter("omega", omega);
+    }
+
+    // Compute the right-hand side of the ODE (dydt arrives sized, nothing is allocated)
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        evalRhs(t, y, dydt);
+    }
+
+    // Statically dispatched right-hand side for any Eigen vector type
+    template <typename StateIn, typename StateOut>
+    void evalRhs(double t, const StateIn& y, StateOut&& dydt) const {
+        const double omega = parameters_[OMEGA];
+        dydt[0] = y[1];
+        dydt[1] = -omega * omega * std::sin(y[0]);
+    }
+
+    bool hasSplitRhs() const override {
+        return true;
+    }
+
+    void positionRhs(double t, const Vec& y, Vec& dqdt) override {
+        dqdt[0] = y[1];
+    }
+
+    void momentumRhs(double t, const Vec& y, Vec& dpdt) override {
+        const double omega = parameters_[OMEGA];
+        dpdt[0] = -omega * omega * std::sin(y[0]);
+    }
+
+    // Analytic Jacobian
+    void jacobian(double t, const Vec& y, Mat& J) override {
+        const double omega = parameters_[OMEGA];
+        J.resize(2, 2);
+        J << 0.0, 1.0,
+             -omega * omega * std::cos(y[0]), 0.0;
+    }
+
+    // Hamiltonian of the state, conserved by the exact flow
+    double energy(const Vec& y) const {
+        const double omega = parameters_[OMEGA];
+        return 0.5 * y[1] * y[1] - omega * omega * std::cos(y[0]);
+    }
+
+    // Copy the pendulum together with its current parameters
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<Pendulum>(*this);
+    }
+};
@@ -0,0 +1,209 @@
+#include "AdaptiveIntegrator.hpp"
+#include "Definitions.hpp"
+#include "TrajectoryIO.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // Dormand–Prince 5(4) tableau
+    constexpr double C2 = 1.0 / 5.0, C3 = 3.0 / 10.0, C4 = 4.0 / 5.0, C5 = 8.0 / 9.0;
+
+    constexpr double A21 = 1.0 / 5.0;
+    constexpr double A31 = 3.0 / 40.0, A32 = 9.0 / 40.0;
+    constexpr double A41 = 44.0 / 45.0, A42 = -56.0 / 15.0, A43 = 32.0 / 9.0;
+    constexpr double A51 = 19372.0 / 6561.0, A52 = -25360.0 / 2187.0, A53 = 64448.0 / 6561.0,
+                     A54 = -212.0 / 729.0;
+    constexpr double A61 = 9017.0 / 3168.0, A62 = -355.0 / 33.0, A63 = 46732.0 / 5247.0,
+                     A64 = 49.0 / 176.0, A65 = -5103.0 / 18656.0;
+    constexpr double A71 = 35.0 / 384.0, A73 = 500.0 / 1113.0, A74 = 125.0 / 192.0,
+                     A75 = -2187.0 / 6784.0, A76 = 11.0 / 84.0;
+
+    // Difference between the 5th and the embedded 4th order solution
+    constexpr double E1 = 71.0 / 57600.0, E3 = -71.0 / 16695.0, E4 = 71.0 / 1920.0,
+                     E5 = -17253.0 / 339200.0, E6 = 22.0 / 525.0, E7 = -1.0 / 40.0;
+
+    // Dense output (Hairer, Nørsett & Wanner, contd5)
+    constexpr double D1 = -12715105075.0 / 11282082432.0, D3 = 87487479700.0 / 32700410799.0,
+                     D4 = -10690763975.0 / 1880347072.0, D5 = 701980252875.0 / 199316789632.0,
+                     D6 = -1453857185.0 / 822651844.0, D7 = 69997945.0 / 29380423.0;
+
+    // Step size controller
+    constexpr double SAFETY = 0.9;
+    constexpr double MIN_FACTOR = 0.2;
+    constexpr double MAX_FACTOR = 10.0;
+}
+
+AdaptiveIntegrator::AdaptiveIntegrator(AbstractDynamicalSystem& system, double initial_dt)
+    : system_(system), initial_dt_(initial_dt) {}
+
+void AdaptiveIntegrator::setTransientTime(double t_transient) {
+    t_transient_ = t_transient;
+}
+
+void AdaptiveIntegrator::setOutputInterval(double interval) {
+    output_interval_ = interval;
+}
+
+void AdaptiveIntegrator::setTolerances(double rel_tol, double abs_tol) {
+    if (rel_tol <= 0.0 || abs_tol < 0.0) {
+        throw std::invalid_argument("AdaptiveIntegrator::setTolerances: tolerances must be positive.");
+    }
+    rel_tol_ = rel_tol;
+    abs_tol_ = abs_tol;
+}
+
+void AdaptiveIntegrator::setMaxStep(double max_dt) {
+    max_dt_ = max_dt;
+}
+
+const Mat& AdaptiveIntegrator::getResults() const {
+    return results_;
+}
+
+const Vec& AdaptiveIntegrator::getTimes() const {
+    return times_;
+}
+
+const IntegratorStats& AdaptiveIntegrator::getStats() const {
+    return stats_;
+}
+
+long long AdaptiveIntegrator::getRhsEvaluations() const {
+    return stats_.rhs_evaluations;
+}
+
+long long AdaptiveIntegrator::getAcceptedSteps() const {
+    return stats_.steps_taken;
+}
+
+long long AdaptiveIntegrator::getRejectedSteps() const {
+    return stats_.steps_rejected;
+}
+
+void AdaptiveIntegrator::integrate(Vec& y, double t0, double tf) {
+    if (system_.dim == 0) {
+        throw std::invalid_argument("AdaptiveIntegrator::integrate: system dimension (dim) must be set and positive.");
+    }
+    if (y.size() != system_.dim) {
+        throw std::invalid_argument("AdaptiveIntegrator::integrate: input vector y size does not match system dimension.");
+    }
+    if (initial_dt_ <= 0.0) {
+        throw std::invalid_argument("AdaptiveIntegrator::integrate: initial step size must be positive.");
+    }
+    int dim = system_.dim;
+    for (Vec* buffer : {&k1_, &k2_, &k3_, &k4_, &k5_, &k6_, &k7_, &y_new_, &y_temp_,
+                        &r1_, &r2_, &r3_, &r4_, &r5_}) {
+        if (buffer->size() != dim) buffer->resize(dim);
+    }
+    stats_ = IntegratorStats();
+    const auto start_time = std::chrono::steady_clock::now();
+    auto recording_start = start_time;
+
+    const double t_rec = std::max(t0, t_transient_);
+    Index num_samples = (output_interval_ > 0.0 && tf > t_rec)
+        ? static_cast<Index>(std::floor((tf - t_rec) / output_interval_ + 1e-9))
+        : 0;
+    if (num_samples > 0) {
+        results_.resize(dim, num_samples);
+        times_.resize(num_samples);
+    } else {
+        results_.resize(dim, 0);
+        times_.resize(0);
+    }
+    Index sample_idx = 0;
+
+    double t = t0;
+    double h = initial_dt_;
+    bool last_rejected = false;
+    const double t_eps = 1e-12 * std::max(1.0, std::abs(tf));
+
+    system_.rhs(t, y, k1_);
+    ++stats_.rhs_evaluations;
+
+    while (t < tf - t_eps) {
+        if (max_dt_ > 0.0) h = std::min(h, max_dt_);
+        if (t + h > tf - t_eps) h = tf - t;
+
+        y_temp_.noalias() = y + h * (A21 * k1_);
+        system_.rhs(t + C2 * h, y_temp_, k2_);
+        y_temp_.noalias() = y + h * (A31 * k1_ + A32 * k2_);
+        system_.rhs(t + C3 * h, y_temp_, k3_);
+        y_temp_.noalias() = y + h * (A41 * k1_ + A42 * k2_ + A43 * k3_);
+        system_.rhs(t + C4 * h, y_temp_, k4_);
+        y_temp_.noalias() = y + h * (A51 * k1_ + A52 * k2_ + A53 * k3_ + A54 * k4_);
+        system_.rhs(t + C5 * h, y_temp_, k5_);
+        y_temp_.noalias() = y + h * (A61 * k1_ + A62 * k2_ + A63 * k3_ + A64 * k4_ + A65 * k5_);
+        system_.rhs(t + h, y_temp_, k6_);
+        y_new_.noalias() = y + h * (A71 * k1_ + A73 * k3_ + A74 * k4_ + A75 * k5_ + A76 * k6_);
+        system_.rhs(t + h, y_new_, k7_);
+        stats_.rhs_evaluations += 6;
+
+        // Scaled RMS norm of the local error estimate
+        y_temp_.noalias() = h * (E1 * k1_ + E3 * k3_ + E4 * k4_ + E5 * k5_ + E6 * k6_ + E7 * k7_);
+        double err = std::sqrt((y_temp_.array()
+            / (abs_tol_ + rel_tol_ * y.array().abs().max(y_new_.array().abs()))).square().mean());
+
+        if (err <= 1.0) {
+            ++stats_.steps_taken;
+
+            // Fill every output time inside (t, t + h] from the dense output of this step
+            double t_sample = t_rec + (sample_idx + 1) * output_interval_;
+            if (sample_idx < num_samples && t_sample <= t + h + t_eps) {
+                r1_ = y;
+                r2_ = y_new_ - y;
+                r3_ = h * k1_ - r2_;
+                r4_ = r2_ - h * k7_ - r3_;
+                r5_.noalias() = h * (D1 * k1_ + D3 * k3_ + D4 * k4_ + D5 * k5_ + D6 * k6_ + D7 * k7_);
+                while (sample_idx < num_samples && t_sample <= t + h + t_eps) {
+                    interpolate(t_sample, t, h, results_.col(sample_idx));
+                    times_(sample_idx) = t_sample;
+                    sample_idx++;
+                    t_sample = t_rec + (sample_idx + 1) * output_interval_;
+                }
+            }
+
+            if (t < t_rec && t + h >= t_rec) {
+                recording_start = std::chrono::steady_clock::now();
+            }
+            t += h;
+            y.swap(y_new_);
+            k1_.swap(k7_);  // FSAL: the last stage is the first stage of the next step
+
+            double factor = (err == 0.0) ? MAX_FACTOR : SAFETY * std::pow(err, -0.2);
+            factor = std::clamp(factor, MIN_FACTOR, MAX_FACTOR);
+            if (last_rejected) factor = std::min(factor, 1.0);
+            h *= factor;
+            last_rejected = false;
+        } else {
+            ++stats_.steps_rejected;
+            h *= std::max(MIN_FACTOR, SAFETY * std::pow(err, -0.2));
+            last_rejected = true;
+            // Only a rejection can shrink h towards zero; accepted steps may end just short of tf
+            if (h < Constants::SMALL_NUMBER * std::max(1.0, std::abs(t))) {
+                throw std::runtime_error("AdaptiveIntegrator::integrate: step size underflow at t = " + std::to_string(t));
+            }
+        }
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    stats_.transient_seconds = std::chrono::duration<double>(recording_start - start_time).count();
+    stats_.recording_seconds = std::chrono::duration<double>(end_time - recording_start).count();
+
+    // Trim unused columns if rounding left the last grid point unfilled
+    if (sample_idx < num_samples) {
+        results_.conservativeResize(Eigen::NoChange, sample_idx);
+        times_.conservativeResize(sample_idx);
+    }
+}
+
+void AdaptiveIntegrator::interpolate(double t_out, double t_old, double h, Eigen::Ref<Vec> y_out) const {
+    const double theta = (t_out - t_old) / h;
+    const double theta1 = 1.0 - theta;
+    y_out = r1_ + theta * (r2_ + theta1 * (r3_ + theta * (r4_ + theta1 * r5_)));
+}
+
+void AdaptiveIntegrator::writeResultsToCSV(const std::string& filename) const {
+    writeTrajectoryCSV(filename, times_, results_);
+}
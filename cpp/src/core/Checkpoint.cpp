@@ -0,0 +1,267 @@
+#include "Checkpoint.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char MAGIC[8] = {'N', 'L', 'D', 'K', 'C', 'K', 'P', '\0'};
+    constexpr std::uint32_t VERSION = 3;  // 2: integration method; 3: sample log and sink state
+    constexpr std::size_t HEADER_BYTES = sizeof(MAGIC) + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    std::uint64_t fnv1a(const char* data, std::size_t size) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void writeAll(int fd, const char* p, std::size_t bytes, const std::string& filename) {
+        while (bytes > 0) {
+            ssize_t written = ::write(fd, p, bytes);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed to write file: " + filename + ": " + std::strerror(errno));
+            }
+            p += written;
+            bytes -= static_cast<std::size_t>(written);
+        }
+    }
+}
+
+CheckpointData::CheckpointData(CheckpointKind kind) : kind_(kind) {}
+
+void CheckpointData::putArray(const double* data, Index size) {
+    const char* p = reinterpret_cast<const char*>(data);
+    payload_.insert(payload_.end(), p, p + sizeof(double) * static_cast<std::size_t>(size));
+}
+
+void CheckpointData::putVec(const Vec& v) {
+    put(static_cast<std::int64_t>(v.size()));
+    putArray(v.data(), v.size());
+}
+
+void CheckpointData::putMat(const Mat& m) {
+    put(static_cast<std::int64_t>(m.rows()));
+    put(static_cast<std::int64_t>(m.cols()));
+    putArray(m.data(), m.size());
+}
+
+void CheckpointData::getArray(double* data, Index size) {
+    const std::size_t bytes = sizeof(double) * static_cast<std::size_t>(size);
+    require(bytes);
+    std::memcpy(data, payload_.data() + offset_, bytes);
+    offset_ += bytes;
+}
+
+Vec CheckpointData::getVec() {
+    Index size = static_cast<Index>(get<std::int64_t>());
+    if (size < 0) throw std::runtime_error("CheckpointData: corrupted vector size.");
+    Vec v(size);
+    getArray(v.data(), size);
+    return v;
+}
+
+Mat CheckpointData::getMat() {
+    Index rows = static_cast<Index>(get<std::int64_t>());
+    Index cols = static_cast<Index>(get<std::int64_t>());
+    if (rows < 0 || cols < 0) throw std::runtime_error("CheckpointData: corrupted matrix size.");
+    Mat m(rows, cols);
+    getArray(m.data(), m.size());
+    return m;
+}
+
+CheckpointKind CheckpointData::kind() const {
+    return kind_;
+}
+
+void CheckpointData::require(std::size_t bytes) const {
+    if (offset_ + bytes > payload_.size()) {
+        throw std::runtime_error("CheckpointData: truncated payload.");
+    }
+}
+
+std::vector<char> CheckpointData::serialize() const {
+    std::vector<char> bytes;
+    bytes.reserve(HEADER_BYTES + payload_.size() + sizeof(std::uint64_t));
+    auto append = [&bytes](const auto& value) {
+        const char* p = reinterpret_cast<const char*>(&value);
+        bytes.insert(bytes.end(), p, p + sizeof(value));
+    };
+    bytes.insert(bytes.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    append(VERSION);
+    append(static_cast<std::uint32_t>(kind_));
+    append(static_cast<std::uint64_t>(payload_.size()));
+    bytes.insert(bytes.end(), payload_.begin(), payload_.end());
+    append(fnv1a(payload_.data(), payload_.size()));
+    return bytes;
+}
+
+CheckpointData CheckpointData::load(const std::string& filename, CheckpointKind kind) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() < HEADER_BYTES + sizeof(std::uint64_t)
+        || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("CheckpointData: not a checkpoint file: " + filename);
+    }
+    std::uint32_t version, stored_kind;
+    std::uint64_t payload_bytes, checksum;
+    std::memcpy(&version, bytes.data() + sizeof(MAGIC), sizeof(version));
+    std::memcpy(&stored_kind, bytes.data() + sizeof(MAGIC) + sizeof(version), sizeof(stored_kind));
+    std::memcpy(&payload_bytes, bytes.data() + sizeof(MAGIC) + 2 * sizeof(version), sizeof(payload_bytes));
+    if (version != VERSION) {
+        throw std::runtime_error("CheckpointData: unsupported format version in " + filename);
+    }
+    if (stored_kind != static_cast<std::uint32_t>(kind)) {
+        throw std::runtime_error("CheckpointData: checkpoint of another kind in " + filename);
+    }
+    if (bytes.size() != HEADER_BYTES + payload_bytes + sizeof(checksum)) {
+        throw std::runtime_error("CheckpointData: truncated checkpoint " + filename);
+    }
+    const char* payload = bytes.data() + HEADER_BYTES;
+    std::memcpy(&checksum, payload + payload_bytes, sizeof(checksum));
+    if (checksum != fnv1a(payload, payload_bytes)) {
+        throw std::runtime_error("CheckpointData: checksum mismatch in " + filename);
+    }
+
+    CheckpointData data(kind);
+    data.payload_.assign(payload, payload + payload_bytes);
+    return data;
+}
+
+void writeCheckpointFile(const std::string& filename, const std::vector<char>& bytes) {
+    const std::string temp = filename + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + temp);
+    }
+    try {
+        writeAll(fd, bytes.data(), bytes.size(), temp);
+        if (::fsync(fd) != 0) {
+            throw std::runtime_error("Failed to sync file: " + temp);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close file: " + temp);
+    }
+    if (::rename(temp.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Failed to rename " + temp + " to " + filename + ": " + std::strerror(errno));
+    }
+}
+
+void appendToFile(const std::string& filename, const std::vector<char>& bytes) {
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    try {
+        writeAll(fd, bytes.data(), bytes.size(), filename);
+        if (::fsync(fd) != 0) {
+            throw std::runtime_error("Failed to sync file: " + filename);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close file: " + filename);
+    }
+}
+
+void resizeFile(const std::string& filename, std::uint64_t bytes) {
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    const bool resized = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0;
+    ::close(fd);
+    if (!resized) {
+        throw std::runtime_error("Failed to resize " + filename + ": " + std::strerror(errno));
+    }
+}
+
+CheckpointWriter::CheckpointWriter() : thread_(&CheckpointWriter::run, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_one();
+    thread_.join();
+}
+
+void CheckpointWriter::submit(const std::string& filename, std::vector<char> bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+        pending_file_ = filename;
+        pending_bytes_ = std::move(bytes);
+        has_pending_ = true;
+    }
+    work_cv_.notify_one();
+}
+
+void CheckpointWriter::append(const std::string& filename, const std::vector<char>& bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+        if (!pending_appends_.empty() && pending_appends_.back().first == filename) {
+            std::vector<char>& queued = pending_appends_.back().second;
+            queued.insert(queued.end(), bytes.begin(), bytes.end());
+        } else {
+            pending_appends_.emplace_back(filename, bytes);
+        }
+    }
+    work_cv_.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return !has_pending_ && pending_appends_.empty() && !busy_; });
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+void CheckpointWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return has_pending_ || !pending_appends_.empty() || stop_; });
+        if (!has_pending_ && pending_appends_.empty()) break;  // Stopping with nothing left to write
+
+        // Appends queued so far precede the checkpoint taken with them
+        auto appends = std::move(pending_appends_);
+        pending_appends_.clear();
+        const bool write_checkpoint = has_pending_;
+        std::string filename = std::move(pending_file_);
+        std::vector<char> bytes = std::move(pending_bytes_);
+        has_pending_ = false;
+        busy_ = true;
+        lock.unlock();
+        try {
+            for (const auto& entry : appends) appendToFile(entry.first, entry.second);
+            if (write_checkpoint) writeCheckpointFile(filename, bytes);
+        } catch (...) {
+            lock.lock();
+            error_ = std::current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+        busy_ = false;
+        idle_cv_.notify_all();
+    }
+}
@@ -0,0 +1,385 @@
+#include "DistributedSweep.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    enum MessageType : std::uint32_t { REQUEST = 1, RESULT = 2, WORK = 3, STOP = 4 };
+
+    struct Header {
+        std::uint32_t type;
+        std::uint64_t first;
+        std::uint64_t count;
+        std::uint64_t payload_bytes;
+    };
+    constexpr std::size_t HEADER_BYTES = sizeof(std::uint32_t) + 3 * sizeof(std::uint64_t);
+    constexpr std::uint64_t MAX_PAYLOAD_BYTES = std::uint64_t(1) << 36;
+    constexpr int POLL_MS = 100;  // Upper bound on the delay of timeout checks
+
+    using Clock = std::chrono::steady_clock;
+
+    void packHeader(const Header& h, char* out) {
+        std::memcpy(out, &h.type, sizeof(h.type));
+        std::memcpy(out + 4, &h.first, sizeof(h.first));
+        std::memcpy(out + 12, &h.count, sizeof(h.count));
+        std::memcpy(out + 20, &h.payload_bytes, sizeof(h.payload_bytes));
+    }
+
+    Header unpackHeader(const char* in) {
+        Header h;
+        std::memcpy(&h.type, in, sizeof(h.type));
+        std::memcpy(&h.first, in + 4, sizeof(h.first));
+        std::memcpy(&h.count, in + 12, sizeof(h.count));
+        std::memcpy(&h.payload_bytes, in + 20, sizeof(h.payload_bytes));
+        return h;
+    }
+
+    // False if the peer is gone; MSG_NOSIGNAL keeps a dead peer from raising SIGPIPE
+    bool sendAll(int fd, const char* p, std::size_t bytes) {
+        while (bytes > 0) {
+            ssize_t sent = ::send(fd, p, bytes, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += sent;
+            bytes -= static_cast<std::size_t>(sent);
+        }
+        return true;
+    }
+
+    bool sendMessage(int fd, std::uint32_t type, std::uint64_t first = 0, std::uint64_t count = 0) {
+        char buffer[HEADER_BYTES];
+        packHeader({type, first, count, 0}, buffer);
+        return sendAll(fd, buffer, HEADER_BYTES);
+    }
+
+    // False on end of file before the first byte; throws on a truncated message
+    bool recvAll(int fd, char* p, std::size_t bytes) {
+        std::size_t received = 0;
+        while (received < bytes) {
+            ssize_t n = ::recv(fd, p + received, bytes - received, 0);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("SweepWorker: connection error: ") + std::strerror(errno));
+            }
+            if (n == 0) {
+                if (received == 0) return false;
+                throw std::runtime_error("SweepWorker: truncated message from the coordinator.");
+            }
+            received += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    sockaddr_un socketAddress(const std::string& path, const char* caller) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument(std::string(caller) + ": socket path is empty or too long: " + path);
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+}
+
+struct SweepCoordinator::Connection {
+    int fd = -1;
+    std::vector<char> inbox;      // Bytes of incomplete messages
+    Index chunk = -1;             // Chunk being evaluated by the worker, -1 if none
+    Clock::time_point assigned;
+    bool waiting = false;         // Asked for work while the queue was empty
+};
+
+SweepCoordinator::SweepCoordinator(const std::string& socket_path, Index num_points, Index chunk_points)
+    : socket_path_(socket_path), num_points_(num_points), chunk_points_(chunk_points) {
+    if (num_points <= 0 || chunk_points <= 0) {
+        throw std::invalid_argument("SweepCoordinator: the number of points and the chunk size must be positive.");
+    }
+    const sockaddr_un address = socketAddress(socket_path, "SweepCoordinator");
+
+    struct stat info;
+    if (::stat(socket_path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            throw std::invalid_argument("SweepCoordinator: path exists and is not a socket: " + socket_path);
+        }
+        ::unlink(socket_path.c_str());  // Left over from an earlier coordinator
+    }
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error(std::string("SweepCoordinator: failed to create socket: ") + std::strerror(errno));
+    }
+    if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listen_fd_, SOMAXCONN) != 0) {
+        const std::string reason = std::strerror(errno);
+        ::close(listen_fd_);
+        throw std::runtime_error("SweepCoordinator: failed to listen on " + socket_path + ": " + reason);
+    }
+
+    const Index num_chunks = (num_points + chunk_points - 1) / chunk_points;
+    stats_.chunks = num_chunks;
+    chunk_done_.assign(static_cast<std::size_t>(num_chunks), 0);
+    chunks_left_ = num_chunks;
+    for (Index c = num_chunks - 1; c >= 0; --c) queue_.push_back(c);
+}
+
+SweepCoordinator::~SweepCoordinator() {
+    for (Connection& connection : connections_) {
+        if (connection.fd >= 0) ::close(connection.fd);
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(socket_path_.c_str());
+    }
+}
+
+void SweepCoordinator::setWorkerTimeout(double seconds) {
+    worker_timeout_ = seconds;
+}
+
+const SweepCoordinator::Stats& SweepCoordinator::getStats() const {
+    return stats_;
+}
+
+void SweepCoordinator::accept() {
+    int fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) return;  // Client gave up before being accepted
+    Connection connection;
+    connection.fd = fd;
+    connections_.push_back(std::move(connection));
+    ++stats_.workers;
+}
+
+bool SweepCoordinator::assign(Connection& connection) {
+    if (queue_.empty()) {
+        connection.waiting = true;
+        return true;
+    }
+    const Index chunk = queue_.back();
+    queue_.pop_back();
+    const Index first = chunk * chunk_points_;
+    const Index count = std::min(chunk_points_, num_points_ - first);
+
+    connection.chunk = chunk;
+    connection.assigned = Clock::now();
+    connection.waiting = false;
+    ++stats_.dispatched;
+    return sendMessage(connection.fd, WORK, static_cast<std::uint64_t>(first), static_cast<std::uint64_t>(count));
+}
+
+void SweepCoordinator::fail(Connection& connection) {
+    if (connection.chunk >= 0) {
+        if (!chunk_done_[connection.chunk]) {
+            queue_.push_back(connection.chunk);  // Handed out next
+            ++stats_.redispatched;
+        }
+        ++stats_.failed_workers;
+        connection.chunk = -1;
+    }
+    ::close(connection.fd);
+    connection.fd = -1;
+}
+
+bool SweepCoordinator::handleMessages(Connection& connection, ResultStore& store, const Mat& coordinates,
+                                      const std::vector<std::string>& axis_names) {
+    bool open = true;
+    char buffer[65536];
+    for (;;) {
+        ssize_t n = ::recv(connection.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            connection.inbox.insert(connection.inbox.end(), buffer, buffer + n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) open = false;
+        break;
+    }
+
+    // Complete messages are processed even if the worker is already gone
+    std::size_t offset = 0;
+    while (connection.inbox.size() - offset >= HEADER_BYTES) {
+        const Header h = unpackHeader(connection.inbox.data() + offset);
+        if (h.payload_bytes > MAX_PAYLOAD_BYTES) return false;
+        if (connection.inbox.size() - offset < HEADER_BYTES + h.payload_bytes) break;
+        const char* payload = connection.inbox.data() + offset + HEADER_BYTES;
+        offset += HEADER_BYTES + h.payload_bytes;
+
+        if (h.type == REQUEST) {
+            if (connection.chunk >= 0) return false;  // Protocol error: one chunk at a time
+            if (!assign(connection)) return false;
+            continue;
+        }
+        if (h.type != RESULT || connection.chunk < 0 || h.payload_bytes < sizeof(std::uint64_t)) return false;
+
+        const Index first = connection.chunk * chunk_points_;
+        const Index count = std::min(chunk_points_, num_points_ - first);
+        std::uint64_t result_dim;
+        std::memcpy(&result_dim, payload, sizeof(result_dim));
+        if (h.first != static_cast<std::uint64_t>(first) || h.count != static_cast<std::uint64_t>(count)
+            || h.payload_bytes != sizeof(std::uint64_t) + sizeof(double) * result_dim * h.count) {
+            return false;
+        }
+        if (!store_begun_) {
+            store.begin(static_cast<Index>(result_dim), coordinates, axis_names);
+            store_begun_ = true;
+        } else if (static_cast<Index>(result_dim) != store.resultDim()) {
+            throw std::runtime_error("SweepCoordinator: workers returned results of different sizes.");
+        }
+
+        if (!chunk_done_[connection.chunk]) {
+            Vec result(static_cast<Index>(result_dim));
+            const char* data = payload + sizeof(std::uint64_t);
+            for (Index k = 0; k < count; ++k) {
+                std::memcpy(result.data(), data + sizeof(double) * result_dim * k, sizeof(double) * result_dim);
+                store.store(first + k, result);
+            }
+            chunk_done_[connection.chunk] = 1;
+            --chunks_left_;
+        }
+        connection.chunk = -1;
+        if (!assign(connection)) return false;
+    }
+    connection.inbox.erase(connection.inbox.begin(), connection.inbox.begin() + static_cast<std::ptrdiff_t>(offset));
+    return open;
+}
+
+void SweepCoordinator::run(ResultStore& store, const Mat& coordinates, const std::vector<std::string>& axis_names) {
+    if (coordinates.cols() != num_points_) {
+        throw std::invalid_argument("SweepCoordinator::run: coordinates do not match the number of points.");
+    }
+
+    std::vector<pollfd> fds;
+    while (chunks_left_ > 0) {
+        fds.clear();
+        fds.push_back({listen_fd_, POLLIN, 0});
+        for (const Connection& connection : connections_) fds.push_back({connection.fd, POLLIN, 0});
+
+        if (::poll(fds.data(), fds.size(), POLL_MS) < 0 && errno != EINTR) {
+            throw std::runtime_error(std::string("SweepCoordinator: poll failed: ") + std::strerror(errno));
+        }
+
+        // fds[k + 1] belongs to the connections present before this round's accept()
+        const std::size_t polled = connections_.size();
+        for (std::size_t k = 0; k < polled; ++k) {
+            Connection& connection = connections_[k];
+            if ((fds[k + 1].revents & (POLLIN | POLLHUP | POLLERR))
+                && !handleMessages(connection, store, coordinates, axis_names)) {
+                fail(connection);
+            }
+        }
+        if (fds[0].revents & POLLIN) accept();
+
+        if (worker_timeout_ > 0.0) {
+            const Clock::time_point now = Clock::now();
+            for (Connection& connection : connections_) {
+                if (connection.fd >= 0 && connection.chunk >= 0
+                    && std::chrono::duration<double>(now - connection.assigned).count() > worker_timeout_) {
+                    fail(connection);
+                }
+            }
+        }
+
+        // Re-queued chunks go to workers that are idle
+        for (Connection& connection : connections_) {
+            if (queue_.empty()) break;
+            if (connection.fd >= 0 && connection.waiting && !assign(connection)) fail(connection);
+        }
+
+        connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+                                          [](const Connection& c) { return c.fd < 0; }),
+                           connections_.end());
+    }
+
+    for (Connection& connection : connections_) {
+        sendMessage(connection.fd, STOP);
+        ::close(connection.fd);
+    }
+    connections_.clear();
+    store.end();
+}
+
+SweepWorker::SweepWorker(const std::string& socket_path, double connect_timeout) {
+    const sockaddr_un address = socketAddress(socket_path, "SweepWorker");
+    const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(connect_timeout));
+
+    // The coordinator may not be listening yet
+    for (;;) {
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd_ < 0) {
+            throw std::runtime_error(std::string("SweepWorker: failed to create socket: ") + std::strerror(errno));
+        }
+        if (::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) return;
+        const int error = errno;
+        ::close(fd_);
+        fd_ = -1;
+        if ((error != ENOENT && error != ECONNREFUSED && error != EAGAIN) || Clock::now() >= deadline) {
+            throw std::runtime_error("SweepWorker: failed to connect to " + socket_path + ": " + std::strerror(error));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+SweepWorker::~SweepWorker() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+Index SweepWorker::run(const PointEvaluator& evaluate) {
+    return run(ChunkEvaluator([&](Index first, Index count) {
+        Vec result = evaluate(first);
+        Mat results(result.size(), count);
+        results.col(0) = result;
+        for (Index k = 1; k < count; ++k) results.col(k) = evaluate(first + k);
+        return results;
+    }));
+}
+
+Index SweepWorker::run(const ChunkEvaluator& evaluate) {
+    if (!sendMessage(fd_, REQUEST)) {
+        throw std::runtime_error("SweepWorker: lost the connection to the coordinator.");
+    }
+
+    Index evaluated = 0;
+    std::vector<char> message;
+    for (;;) {
+        char buffer[HEADER_BYTES];
+        if (!recvAll(fd_, buffer, HEADER_BYTES)) {
+            throw std::runtime_error("SweepWorker: the coordinator closed the connection.");
+        }
+        const Header h = unpackHeader(buffer);
+        if (h.type == STOP) break;
+        if (h.type != WORK || h.payload_bytes != 0) {
+            throw std::runtime_error("SweepWorker: unexpected message from the coordinator.");
+        }
+
+        const Index first = static_cast<Index>(h.first);
+        const Index count = static_cast<Index>(h.count);
+        const Mat results = evaluate(first, count);
+        if (results.cols() != count) {
+            throw std::runtime_error("SweepWorker: the chunk evaluator returned the wrong number of points.");
+        }
+
+        const std::uint64_t result_dim = static_cast<std::uint64_t>(results.rows());
+        const std::size_t data_bytes = sizeof(double) * static_cast<std::size_t>(results.size());
+        message.resize(HEADER_BYTES + sizeof(result_dim) + data_bytes);
+        packHeader({RESULT, h.first, h.count, sizeof(result_dim) + data_bytes}, message.data());
+        std::memcpy(message.data() + HEADER_BYTES, &result_dim, sizeof(result_dim));
+        std::memcpy(message.data() + HEADER_BYTES + sizeof(result_dim), results.data(), data_bytes);
+        if (!sendAll(fd_, message.data(), message.size())) {
+            throw std::runtime_error("SweepWorker: lost the connection to the coordinator.");
+        }
+        evaluated += count;
+    }
+    return evaluated;
+}
@@ -0,0 +1,113 @@
+#include "EnsembleIntegrator.hpp"
+#include "Definitions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+EnsembleIntegrator::EnsembleIntegrator(AbstractDynamicalSystem& system, double dt)
+    : system_(system), dt_(dt) {}
+
+void EnsembleIntegrator::setTransientTime(double t_transient) {
+    t_transient_ = t_transient;
+}
+
+void EnsembleIntegrator::setOutputInterval(double interval) {
+    output_interval_ = interval;
+}
+
+const Mat& EnsembleIntegrator::getResults() const {
+    return results_;
+}
+
+const Vec& EnsembleIntegrator::getTimes() const {
+    return times_;
+}
+
+Mat EnsembleIntegrator::getMemberResults(Index member) const {
+    if (member < 0 || member >= members_) {
+        throw std::out_of_range("EnsembleIntegrator::getMemberResults: member index out of range.");
+    }
+    Index dim = system_.dim;
+    Mat trajectory(dim, results_.cols());
+    for (Index i = 0; i < dim; ++i) {
+        trajectory.row(i) = results_.row(i * members_ + member);
+    }
+    return trajectory;
+}
+
+void EnsembleIntegrator::step(double t, BatchMat& Y) {
+    const double dt_half = dt_ / 2.0;
+    const double dt_sixth = dt_ / 6.0;
+    system_.rhsBatch(t, Y, k1_);
+    y_temp_.noalias() = Y + dt_half * k1_;
+    system_.rhsBatch(t + dt_half, y_temp_, k2_);
+    y_temp_.noalias() = Y + dt_half * k2_;
+    system_.rhsBatch(t + dt_half, y_temp_, k3_);
+    y_temp_.noalias() = Y + dt_ * k3_;
+    system_.rhsBatch(t + dt_, y_temp_, k4_);
+    Y.noalias() += dt_sixth * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+}
+
+void EnsembleIntegrator::integrate(BatchMat& Y, double t0, double tf) {
+    if (system_.dim == 0) {
+        throw std::invalid_argument("EnsembleIntegrator::integrate: system dimension (dim) must be set and positive.");
+    }
+    if (!system_.hasBatchRhs()) {
+        throw std::invalid_argument("EnsembleIntegrator::integrate: system does not provide rhsBatch().");
+    }
+    if (Y.rows() != system_.dim) {
+        throw std::invalid_argument("EnsembleIntegrator::integrate: ensemble block rows do not match system dimension.");
+    }
+    int dim = system_.dim;
+    members_ = Y.cols();
+    for (BatchMat* buffer : {&k1_, &k2_, &k3_, &k4_, &y_temp_}) {
+        if (buffer->rows() != dim || buffer->cols() != members_) buffer->resize(dim, members_);
+    }
+
+    double t = t0;
+    // 64-bit counts, as in Integrator: long runs with fine output exceed the int range
+    Index num_samples = (output_interval_ > 0.0)
+        ? static_cast<Index>(std::floor((tf - t_transient_) / output_interval_)) + 1
+        : 0;
+
+    int steps_per_sample = 0;
+    if (output_interval_ > 0.0) {
+        steps_per_sample = static_cast<int>(std::round(output_interval_ / dt_));
+        if (steps_per_sample <= 0) steps_per_sample = 1;
+    }
+
+    // Transient phase
+    while (t < t_transient_) {
+        step(t, Y);
+        t += dt_;
+    }
+
+    long long max_steps = static_cast<long long>(std::ceil((tf - t) / dt_));
+
+    // Exact sample count, now that the main-phase steps are known: results are sized once,
+    // so repeated runs reuse their storage instead of trimming it afterwards
+    if (num_samples > 0) {
+        const Index samples = (max_steps > 0) ? (max_steps + steps_per_sample - 1) / steps_per_sample : 1;
+        num_samples = std::min(num_samples, samples);
+    }
+    results_.resize(dim * members_, num_samples);  // No-op when the size is unchanged
+    times_.resize(num_samples);
+
+    // Main phase
+    for (Index sample_idx = 0; sample_idx < num_samples; ++sample_idx) {
+        for (int s = 0; s < steps_per_sample && max_steps > 0; ++s, --max_steps) {
+            step(t, Y);
+            t += dt_;
+        }
+        // Row-major storage flattens to component * N + member
+        results_.col(sample_idx) = Eigen::Map<const Vec>(Y.data(), dim * members_);
+        times_(sample_idx) = t;
+    }
+    // Without output recording the ensemble is still advanced to tf
+    if (num_samples == 0) {
+        for (; max_steps > 0; --max_steps) {
+            step(t, Y);
+            t += dt_;
+        }
+    }
+}
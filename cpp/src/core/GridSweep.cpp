@@ -0,0 +1,281 @@
+#include "GridSweep.hpp"
+#include "Integrator.hpp"
+#include "ThreadPool.hpp"
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Joe–Kuo (new-joe-kuo-6.21201) primitive polynomials and initial direction numbers
+    // for Sobol dimensions 2 to 10; dimension 1 is the van der Corput sequence.
+    struct SobolInit {
+        unsigned s;     // Polynomial degree
+        unsigned a;     // Polynomial coefficients
+        unsigned m[5];  // Initial direction numbers
+    };
+    constexpr SobolInit SOBOL_INIT[9] = {
+        {1, 0, {1}},           {2, 1, {1, 3}},          {3, 1, {1, 3, 1}},
+        {3, 2, {1, 1, 1}},     {4, 1, {1, 1, 3, 3}},    {4, 4, {1, 3, 5, 13}},
+        {5, 2, {1, 1, 5, 5, 17}}, {5, 4, {1, 1, 5, 5, 5}}, {5, 7, {1, 1, 7, 11, 19}}};
+    constexpr int SOBOL_BITS = 32;
+    constexpr int SOBOL_MAX_DIMS = 10;
+}
+
+GridSweep::GridSweep(AbstractDynamicalSystem& system)
+    : system_(system), own_store_(std::make_unique<ResultStore>()) {}
+
+void GridSweep::addAxis(const std::string& param_name, double start, double end, int num_points) {
+    if (num_points < 1) {
+        throw std::invalid_argument("GridSweep::addAxis: an axis needs at least one point.");
+    }
+    axes_.push_back({param_name, start, end, num_points});
+}
+
+void GridSweep::setSampling(Sampling sampling, Index num_samples, std::uint64_t seed) {
+    if (sampling != Sampling::Grid && num_samples <= 0) {
+        throw std::invalid_argument("GridSweep::setSampling: random and Sobol sampling need a positive number of samples.");
+    }
+    sampling_ = sampling;
+    num_samples_ = num_samples;
+    seed_ = seed;
+}
+
+void GridSweep::setTimeStep(double dt) {
+    dt_ = dt;
+}
+
+void GridSweep::setTransientTime(double transient_time) {
+    transient_time_ = transient_time;
+}
+
+void GridSweep::setOutputInterval(double interval) {
+    output_interval_ = interval;
+}
+
+void GridSweep::setPostProcessingFunction(PostProcessFunc func) {
+    post_process_ = func;
+}
+
+void GridSweep::setPointFunction(PointFunc func) {
+    point_func_ = func;
+}
+
+void GridSweep::setNumThreads(int num_threads) {
+    num_threads_ = num_threads;
+}
+
+void GridSweep::setResultStore(ResultStore* store) {
+    store_ = store;
+}
+
+const ResultStore& GridSweep::getResults() const {
+    return store_ ? *store_ : *own_store_;
+}
+
+Mat GridSweep::sobolSequence(Index num_points, int dims) {
+    if (dims < 1 || dims > SOBOL_MAX_DIMS) {
+        throw std::invalid_argument("GridSweep::sobolSequence: supports 1 to 10 dimensions.");
+    }
+    if (num_points >= (Index(1) << SOBOL_BITS) - 1) {
+        throw std::invalid_argument("GridSweep::sobolSequence: too many points for 32-bit direction numbers.");
+    }
+
+    // Direction numbers v_k = m_k / 2^k as 32-bit fixed point
+    std::vector<std::array<std::uint32_t, SOBOL_BITS>> v(static_cast<std::size_t>(dims));
+    for (int k = 1; k <= SOBOL_BITS; ++k) {
+        v[0][k - 1] = std::uint32_t(1) << (SOBOL_BITS - k);
+    }
+    for (int d = 1; d < dims; ++d) {
+        const SobolInit& init = SOBOL_INIT[d - 1];
+        const int s = static_cast<int>(init.s);
+        for (int k = 1; k <= s; ++k) {
+            v[d][k - 1] = init.m[k - 1] << (SOBOL_BITS - k);
+        }
+        for (int k = s + 1; k <= SOBOL_BITS; ++k) {
+            std::uint32_t value = v[d][k - s - 1] ^ (v[d][k - s - 1] >> s);
+            for (int j = 1; j < s; ++j) {
+                if ((init.a >> (s - 1 - j)) & 1u) value ^= v[d][k - j - 1];
+            }
+            v[d][k - 1] = value;
+        }
+    }
+
+    // Gray-code order: point i + 1 differs from point i in the direction of the lowest zero bit of i
+    Mat points(dims, num_points);
+    std::vector<std::uint32_t> x(static_cast<std::size_t>(dims), 0);
+    for (Index i = 0; i < num_points; ++i) {
+        int c = 0;
+        for (std::uint64_t bits = static_cast<std::uint64_t>(i); bits & 1u; bits >>= 1) ++c;
+        for (int d = 0; d < dims; ++d) {
+            x[d] ^= v[d][c];
+            points(d, i) = std::ldexp(static_cast<double>(x[d]), -SOBOL_BITS);
+        }
+    }
+    return points;
+}
+
+Mat GridSweep::generatePoints() const {
+    const Index num_axes = static_cast<Index>(axes_.size());
+    Mat points;
+
+    if (sampling_ == Sampling::Grid) {
+        Index total = num_axes > 0 ? 1 : 0;
+        for (const Axis& axis : axes_) total *= axis.num_points;
+        points.resize(num_axes, total);
+        for (Index i = 0; i < total; ++i) {
+            Index rest = i;
+            for (Index a = 0; a < num_axes; ++a) {
+                const Axis& axis = axes_[a];
+                const Index k = rest % axis.num_points;
+                rest /= axis.num_points;
+                points(a, i) = (axis.num_points < 2)
+                    ? axis.start
+                    : axis.start + k * (axis.end - axis.start) / (axis.num_points - 1);
+            }
+        }
+        return points;
+    }
+
+    // Unit-cube samples, then scaled to the axis ranges
+    if (sampling_ == Sampling::Sobol) {
+        points = sobolSequence(num_samples_, static_cast<int>(num_axes));
+    } else {
+        std::mt19937_64 rng(seed_);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        points.resize(num_axes, num_samples_);
+        for (Index i = 0; i < num_samples_; ++i) {
+            for (Index a = 0; a < num_axes; ++a) points(a, i) = uniform(rng);
+        }
+    }
+    for (Index a = 0; a < num_axes; ++a) {
+        points.row(a) = (axes_[a].start + (axes_[a].end - axes_[a].start) * points.row(a).array()).matrix();
+    }
+    return points;
+}
+
+Vec GridSweep::evaluatePoint(SweepWorkspace& workspace, const std::vector<ParamHandle>& handles,
+                             const Mat& points, Index i, const Vec& y0, double t0, double tf) const {
+    for (std::size_t a = 0; a < handles.size(); ++a) {
+        workspace.system.setResolvedParameter(handles[a], axes_[a].name, points(static_cast<Index>(a), i));
+    }
+    if (point_func_) {
+        return point_func_(workspace.system, y0, t0, tf);
+    }
+    return post_process_(workspace.integrate(y0, t0, tf));
+}
+
+std::vector<std::unique_ptr<SweepWorkspace>> GridSweep::makeWorkspaces(
+    int num_workers, std::vector<std::unique_ptr<AbstractDynamicalSystem>>& systems) const {
+    std::vector<std::unique_ptr<SweepWorkspace>> workspaces;
+    for (int w = 0; w < num_workers; ++w) {
+        systems.push_back(system_.clone());
+        workspaces.push_back(std::make_unique<SweepWorkspace>(*systems.back(), dt_, transient_time_, output_interval_));
+    }
+    return workspaces;
+}
+
+void GridSweep::runSweep(const Vec& y0, double t0, double tf) {
+    if (!post_process_ && !point_func_) {
+        std::cerr << "Post-processing function is not set!" << std::endl;
+        return;
+    }
+    if (axes_.empty()) {
+        throw std::invalid_argument("GridSweep::runSweep: no parameter axis defined.");
+    }
+
+    const Mat points = generatePoints();
+    const Index num_points = points.cols();
+    ResultStore& store = store_ ? *store_ : *own_store_;
+
+    std::vector<std::string> names;
+    std::vector<ParamHandle> handles;
+    for (const Axis& axis : axes_) {
+        names.push_back(axis.name);
+        handles.push_back(system_.resolveParameter(axis.name));  // Clones share the handles
+    }
+
+    // The first point fixes the result size of the store
+    SweepWorkspace workspace(system_, dt_, transient_time_, output_interval_);
+    Vec first = evaluatePoint(workspace, handles, points, 0, y0, t0, tf);
+    store.begin(first.size(), points, names);
+    store.store(0, first);
+
+    if (num_threads_ == 1) {
+        for (Index i = 1; i < num_points; ++i) {
+            store.store(i, evaluatePoint(workspace, handles, points, i, y0, t0, tf));
+        }
+    } else {
+        ThreadPool pool(num_threads_);
+        std::vector<std::unique_ptr<AbstractDynamicalSystem>> systems;
+        auto workspaces = makeWorkspaces(pool.size(), systems);
+        pool.parallelFor(num_points - 1, [&](Index k, int worker) {
+            store.store(k + 1, evaluatePoint(*workspaces[worker], handles, points, k + 1, y0, t0, tf));
+        });
+    }
+    store.end();
+}
+
+SweepCoordinator::Stats GridSweep::runCoordinator(const std::string& socket_path, Index chunk_points,
+                                                  double worker_timeout) {
+    if (axes_.empty()) {
+        throw std::invalid_argument("GridSweep::runCoordinator: no parameter axis defined.");
+    }
+    const Mat points = generatePoints();
+    std::vector<std::string> names;
+    for (const Axis& axis : axes_) names.push_back(axis.name);
+
+    SweepCoordinator coordinator(socket_path, points.cols(), chunk_points);
+    coordinator.setWorkerTimeout(worker_timeout);
+    coordinator.run(store_ ? *store_ : *own_store_, points, names);
+    return coordinator.getStats();
+}
+
+Index GridSweep::runWorker(const std::string& socket_path, const Vec& y0, double t0, double tf) {
+    if (!post_process_ && !point_func_) {
+        throw std::invalid_argument("GridSweep::runWorker: post-processing function is not set.");
+    }
+    if (axes_.empty()) {
+        throw std::invalid_argument("GridSweep::runWorker: no parameter axis defined.");
+    }
+
+    const Mat points = generatePoints();
+    std::vector<ParamHandle> handles;
+    for (const Axis& axis : axes_) {
+        handles.push_back(system_.resolveParameter(axis.name));
+    }
+    // The coordinator's grid may differ from this worker's: never index past the local one
+    auto checkRange = [&](Index first, Index count) {
+        if (first < 0 || count <= 0 || first + count > points.cols()) {
+            throw std::runtime_error("GridSweep::runWorker: chunk of " + std::to_string(count) + " points at "
+                                     + std::to_string(first) + " is outside the grid of "
+                                     + std::to_string(points.cols()) + " points.");
+        }
+    };
+
+    SweepWorker worker(socket_path);
+    if (num_threads_ == 1) {
+        SweepWorkspace workspace(system_, dt_, transient_time_, output_interval_);
+        return worker.run(SweepWorker::PointEvaluator([&](Index i) {
+            checkRange(i, 1);
+            return evaluatePoint(workspace, handles, points, i, y0, t0, tf);
+        }));
+    }
+
+    ThreadPool pool(num_threads_);
+    std::vector<std::unique_ptr<AbstractDynamicalSystem>> systems;
+    auto workspaces = makeWorkspaces(pool.size(), systems);
+    std::vector<Vec> results;
+    return worker.run(SweepWorker::ChunkEvaluator([&](Index first, Index count) {
+        checkRange(first, count);
+        results.assign(static_cast<std::size_t>(count), Vec());
+        pool.parallelFor(count, [&](Index k, int w) {
+            results[k] = evaluatePoint(*workspaces[w], handles, points, first + k, y0, t0, tf);
+        });
+        Mat chunk(results[0].size(), count);
+        for (Index k = 0; k < count; ++k) chunk.col(k) = results[k];
+        return chunk;
+    }));
+}
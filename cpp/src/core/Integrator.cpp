@@ -1,11 +1,37 @@
-#include <fstream>
-#include <iomanip>
 #include "Integrator.hpp"
 #include "Definitions.hpp"
 #include <iostream>
 #include <cmath>
 #include <stdexcept>
 #include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    // Substep weights of the Verlet compositions (they sum to 1)
+    constexpr double VERLET[1] = {1.0};
+    constexpr double YOSHIDA4[3] = {1.3512071919596578, -1.7024143839193153, 1.3512071919596578};  // 1 / (2 - 2^(1/3)), ...
+    constexpr double YOSHIDA6[7] = {0.784513610477560, 0.235573213359357, -1.17767998417887, 1.31518632068391,
+                                    -1.17767998417887, 0.235573213359357, 0.784513610477560};
+
+    // Samples of a checkpointed run without a sink: one record (time, then the state) per sample
+    std::string sampleLog(const std::string& checkpoint) {
+        return checkpoint + ".samples";
+    }
+
+    std::vector<char> sampleRecords(const Vec& times, const Mat& states, Index first, Index last) {
+        const std::size_t record = sizeof(double) * static_cast<std::size_t>(states.rows() + 1);
+        std::vector<char> bytes(record * static_cast<std::size_t>(last - first));
+        char* out = bytes.data();
+        for (Index k = first; k < last; ++k, out += record) {
+            std::memcpy(out, &times(k), sizeof(double));
+            std::memcpy(out + sizeof(double), states.col(k).data(), record - sizeof(double));
+        }
+        return bytes;
+    }
+}
 
 Integrator::Integrator(AbstractDynamicalSystem& system, double dt)
     : system_(system), dt_(dt) {}
@@ -18,6 +44,10 @@ void Integrator::setOutputInterval(double interval) {
     output_interval_ = interval;
 }
 
+void Integrator::setMethod(Method method) {
+    method_ = method;
+}
+
 const Mat& Integrator::getResults() const {
     return results_;
 }
@@ -26,6 +56,287 @@ const Vec& Integrator::getTimes() const {
     return times_;
 }
 
+double Integrator::getFinalTime() const {
+    return t_final_;
+}
+
+const IntegratorStats& Integrator::getStats() const {
+    return stats_;
+}
+
+long long Integrator::getRhsEvaluations() const {
+    return stats_.rhs_evaluations;
+}
+
+void Integrator::setSink(TrajectorySink* sink, int chunk_size) {
+    if (sink && chunk_size <= 0) {
+        throw std::invalid_argument("Integrator::setSink: chunk size must be positive.");
+    }
+    sink_ = sink;
+    chunk_size_ = chunk_size;
+}
+
+void Integrator::step(double t, Vec& y) {
+    if (method_ != Method::RK4) {
+        symplecticStep(t, y);
+        return;
+    }
+    const double dt_half = dt_ / 2.0;
+    const double dt_sixth = dt_ / 6.0;
+    system_.rhs(t, y, k1_);
+    y_temp_.noalias() = y;
+    y_temp_.noalias() += dt_half * k1_;
+    system_.rhs(t + dt_half, y_temp_, k2_);
+    y_temp_.noalias() = y;
+    y_temp_.noalias() += dt_half * k2_;
+    system_.rhs(t + dt_half, y_temp_, k3_);
+    y_temp_.noalias() = y;
+    y_temp_.noalias() += dt_ * k3_;
+    system_.rhs(t + dt_, y_temp_, k4_);
+    y.noalias() += dt_sixth * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+    stats_.rhs_evaluations += 4;
+    ++stats_.steps_taken;
+}
+
+void Integrator::symplecticStep(double t, Vec& y) {
+    const double* w = VERLET;
+    int stages = 1;
+    if (method_ == Method::Yoshida4) {
+        w = YOSHIDA4;
+        stages = 3;
+    } else if (method_ == Method::Yoshida6) {
+        w = YOSHIDA6;
+        stages = 7;
+    }
+    const Index n = system_.dim / 2;
+
+    // Kick-drift-kick Verlet substeps with the adjacent half kicks merged; the closing
+    // force is reused as the opening force of the next step
+    if (!force_valid_) {
+        system_.momentumRhs(t, y, dp_);
+        ++stats_.rhs_evaluations;
+    }
+    y.tail(n).noalias() += (0.5 * w[0] * dt_) * dp_;
+    double tq = t;
+    for (int i = 0; i < stages; ++i) {
+        system_.positionRhs(tq, y, dq_);
+        y.head(n).noalias() += (w[i] * dt_) * dq_;
+        tq += w[i] * dt_;
+        system_.momentumRhs(tq, y, dp_);
+        ++stats_.rhs_evaluations;
+        const double kick = (i + 1 < stages) ? 0.5 * (w[i] + w[i + 1]) : 0.5 * w[i];
+        y.tail(n).noalias() += (kick * dt_) * dp_;
+    }
+    force_valid_ = true;
+    ++stats_.steps_taken;
+}
+
+void Integrator::recordSample(Index sample_idx, double t, const Vec& y) {
+    if (!sink_) {
+        results_.col(sample_idx) = y;
+        times_(sample_idx) = t;
+        return;
+    }
+    chunk_states_.col(chunk_fill_) = y;
+    chunk_times_(chunk_fill_) = t;
+    if (++chunk_fill_ == chunk_states_.cols()) {
+        flushChunk();
+    }
+}
+
+void Integrator::flushChunk() {
+    if (chunk_fill_ > 0) {
+        sink_->consume(chunk_states_.leftCols(chunk_fill_), chunk_times_.head(chunk_fill_));
+        chunk_fill_ = 0;
+    }
+}
+
+int Integrator::addEvent(const Event& event) {
+    if (!event.g) {
+        throw std::invalid_argument("Integrator::addEvent: switching function is not set.");
+    }
+    events_.push_back(event);
+    return static_cast<int>(events_.size()) - 1;
+}
+
+void Integrator::clearEvents() {
+    events_.clear();
+}
+
+Vec Integrator::getEventTimes() const {
+    return Eigen::Map<const Vec>(event_times_.data(), static_cast<Index>(event_times_.size()));
+}
+
+Mat Integrator::getEventStates() const {
+    return Eigen::Map<const Mat>(event_states_.data(), system_.dim, static_cast<Index>(event_times_.size()));
+}
+
+const std::vector<int>& Integrator::getEventIds() const {
+    return event_ids_;
+}
+
+bool Integrator::terminated() const {
+    return terminated_;
+}
+
+void Integrator::hermite(double theta, const Vec& y_new, Vec& y_out) const {
+    // Cubic Hermite interpolant through (y_prev_, k1_) at the start and (y_new, f_new_) at the end
+    const double theta2 = theta * theta;
+    const double theta3 = theta2 * theta;
+    const double h00 = 2.0 * theta3 - 3.0 * theta2 + 1.0;
+    const double h10 = (theta3 - 2.0 * theta2 + theta) * dt_;
+    const double h01 = -2.0 * theta3 + 3.0 * theta2;
+    const double h11 = (theta3 - theta2) * dt_;
+    y_out = h00 * y_prev_ + h10 * k1_ + h01 * y_new + h11 * f_new_;
+}
+
+bool Integrator::stepWithEvents(double& t, Vec& y) {
+    const double t_prev = t;
+    y_prev_ = y;
+    step(t, y);  // RK4 leaves f(t_prev, y_prev) in k1_
+    t += dt_;
+
+    bool have_f_new = false;
+    double t_stop = t;
+    int first_new = static_cast<int>(event_times_.size());
+
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+        const Event& event = events_[i];
+        const double g_old = g_prev_(i);
+        const double g_new = event.g(t, y);
+        g_prev_(i) = g_new;
+
+        const bool rising = g_old < 0.0 && g_new >= 0.0;
+        const bool falling = g_old > 0.0 && g_new <= 0.0;
+        if (!((rising && event.direction != Event::Direction::Falling)
+              || (falling && event.direction != Event::Direction::Rising))) {
+            continue;
+        }
+
+        if (!have_f_new) {
+            system_.rhs(t, y, f_new_);
+            ++stats_.rhs_evaluations;
+            if (method_ != Method::RK4) {
+                system_.rhs(t_prev, y_prev_, k1_);  // Only RK4 leaves it from the step
+                ++stats_.rhs_evaluations;
+            }
+            have_f_new = true;
+        }
+
+        // Illinois (modified regula falsi) on the interpolated switching function
+        Vec& y_theta = y_temp_;
+        double a = 0.0, b = 1.0, ga = g_old, gb = g_new;
+        int side = 0;
+        double theta = 1.0;
+        for (int iter = 0; iter < 60 && (b - a) > 1e-14; ++iter) {
+            theta = (a * gb - b * ga) / (gb - ga);
+            hermite(theta, y, y_theta);
+            double g_theta = event.g(t_prev + theta * dt_, y_theta);
+            if (g_theta == 0.0) break;
+            if ((g_theta < 0.0) == (ga < 0.0)) {
+                a = theta;
+                ga = g_theta;
+                if (side == -1) gb *= 0.5;
+                side = -1;
+            } else {
+                b = theta;
+                gb = g_theta;
+                if (side == 1) ga *= 0.5;
+                side = 1;
+            }
+        }
+        hermite(theta, y, y_theta);
+
+        const double t_event = t_prev + theta * dt_;
+        if (t_event > t_stop) continue;  // Beyond an earlier terminal crossing of this step
+
+        // Insert in time order among the crossings of this step
+        std::size_t pos = event_times_.size();
+        while (pos > static_cast<std::size_t>(first_new) && event_times_[pos - 1] > t_event) --pos;
+        event_times_.insert(event_times_.begin() + pos, t_event);
+        event_ids_.insert(event_ids_.begin() + pos, static_cast<int>(i));
+        event_states_.insert(event_states_.begin() + pos * y.size(), y_theta.data(), y_theta.data() + y.size());
+
+        if (event.terminal) {
+            t_stop = t_event;
+            y_event_ = y_theta;  // Remember the state at the terminal crossing
+            terminated_ = true;
+        }
+    }
+
+    if (!terminated_) return true;
+
+    // Drop crossings after the terminal one and stop there
+    std::size_t keep = event_times_.size();
+    while (keep > static_cast<std::size_t>(first_new) && event_times_[keep - 1] > t_stop) --keep;
+    event_times_.resize(keep);
+    event_ids_.resize(keep);
+    event_states_.resize(keep * y.size());
+    y = y_event_;
+    t = t_stop;
+    return false;
+}
+
+void Integrator::setCheckpoint(const std::string& filename, long long every_steps) {
+    if (!filename.empty() && every_steps <= 0) {
+        throw std::invalid_argument("Integrator::setCheckpoint: checkpoint interval must be positive.");
+    }
+    checkpoint_file_ = filename;
+    checkpoint_every_ = filename.empty() ? 0 : every_steps;
+    if (checkpoint_every_ > 0 && !writer_) {
+        writer_ = std::make_unique<CheckpointWriter>();
+    }
+}
+
+void Integrator::prepareBuffers() {
+    const int dim = system_.dim;
+    if (method_ != Method::RK4) {
+        if (!system_.hasSplitRhs() || dim % 2 != 0) {
+            throw std::invalid_argument("Integrator: symplectic methods require a system with a split position/momentum right-hand side.");
+        }
+        if (dq_.size() != dim / 2) {
+            dq_.resize(dim / 2);
+            dp_.resize(dim / 2);
+        }
+    }
+    if (k1_.size() != dim) {
+        k1_.resize(dim);
+        k2_.resize(dim);
+        k3_.resize(dim);
+        k4_.resize(dim);
+    }
+    if (y_temp_.size() != dim) {
+        y_temp_.resize(dim);
+    }
+    if (!events_.empty()) {
+        for (Vec* buffer : {&y_prev_, &f_new_, &y_event_}) {
+            if (buffer->size() != dim) buffer->resize(dim);
+        }
+    }
+}
+
+void Integrator::prepareOutput(const Progress& p) {
+    const int dim = system_.dim;
+    const Index num_samples = p.num_samples;
+    if (sink_) {
+        // Streaming: only one chunk of samples is held in memory at a time
+        results_.resize(dim, 0);
+        times_.resize(0);
+        if (num_samples > 0) {
+            Index chunk = std::min<Index>(chunk_size_, num_samples);
+            if (chunk_states_.rows() != dim || chunk_states_.cols() != chunk) {
+                chunk_states_.resize(dim, chunk);
+                chunk_times_.resize(chunk);
+            }
+        }
+        chunk_fill_ = 0;
+    } else if (num_samples > 0 && !p.in_transient) {
+        // Resumed after the transient; otherwise sized when the transient ends
+        results_.resize(dim, num_samples);
+        times_.resize(num_samples);
+    }
+}
+
 void Integrator::integrate(Vec& y, double t0, double tf) {
     if (system_.dim == 0) {
         throw std::invalid_argument("Integrator::integrate: system dimension (dim) must be set and positive.");
@@ -33,106 +344,278 @@ void Integrator::integrate(Vec& y, double t0, double tf) {
     if (y.size() != system_.dim) {
         throw std::invalid_argument("Integrator::integrate: input vector y size does not match system dimension.");
     }
-    if (k1_.size() != system_.dim) {
-        k1_.resize(system_.dim);
-        k2_.resize(system_.dim);
-        k3_.resize(system_.dim);
-        k4_.resize(system_.dim);
+    prepareBuffers();
+
+    Progress p;
+    p.t0 = t0;
+    p.tf = tf;
+    p.t = t0;
+    // 64-bit counts: long runs with fine output exceed the int range
+    p.num_samples = (output_interval_ > 0.0)
+        ? static_cast<Index>(std::floor((tf - t_transient_) / output_interval_)) + 1
+        : 0;
+    prepareOutput(p);
+    if (sink_) sink_->begin(system_.dim);
+    if (checkpoint_every_ > 0 && !sink_) {
+        writer_->flush();  // No append of an earlier run may land after the reset
+        resizeFile(sampleLog(checkpoint_file_), 0);
+    }
+    logged_samples_ = 0;
+
+    stats_ = IntegratorStats();
+    event_times_.clear();
+    event_states_.clear();
+    event_ids_.clear();
+    terminated_ = false;
+    run(y, p);
+}
+
+void Integrator::resume(Vec& y, const std::string& filename) {
+    CheckpointData data = CheckpointData::load(filename, CheckpointKind::Integrator);
+    const int dim = system_.dim;
+    if (data.get<std::int64_t>() != dim) {
+        throw std::invalid_argument("Integrator::resume: checkpoint dimension does not match the system.");
     }
-    if (y_temp_.size() != system_.dim) {
-        y_temp_.resize(system_.dim);
+    const double dt = data.get<double>();
+    const double t_transient = data.get<double>();
+    const double output_interval = data.get<double>();
+    const std::int64_t num_events = data.get<std::int64_t>();
+    const auto method = static_cast<Method>(data.get<std::int32_t>());
+    if (dt != dt_ || t_transient != t_transient_ || output_interval != output_interval_
+        || num_events != static_cast<std::int64_t>(events_.size()) || method != method_) {
+        throw std::invalid_argument("Integrator::resume: integrator settings differ from the checkpointed run.");
     }
-    double t = t0;
-    const double dt_half = dt_ / 2.0;
-    const double dt_sixth = dt_ / 6.0;
-    int dim = system_.dim;
-    int num_samples = (output_interval_ > 0.0)
-        ? static_cast<int>(std::floor((tf - t_transient_) / output_interval_)) + 1
-        : 0;
 
-    int steps_per_sample = 0;
-    if (output_interval_ > 0.0) {
-        steps_per_sample = static_cast<int>(std::round(output_interval_ / dt_));
-        if (steps_per_sample <= 0) steps_per_sample = 1;
+    Progress p;
+    p.t0 = data.get<double>();
+    p.tf = data.get<double>();
+    p.t = data.get<double>();
+    p.in_transient = data.get<std::uint8_t>() != 0;
+    p.num_samples = static_cast<Index>(data.get<std::int64_t>());
+    p.sample_idx = static_cast<Index>(data.get<std::int64_t>());
+    p.step_idx = data.get<std::int32_t>();
+    p.max_steps = data.get<std::int64_t>();
+
+    stats_ = IntegratorStats();
+    stats_.rhs_evaluations = data.get<long long>();
+    stats_.steps_taken = data.get<long long>();
+    stats_.steps_rejected = data.get<long long>();
+    stats_.jacobian_evaluations = data.get<long long>();
+    stats_.factorizations = data.get<long long>();
+    stats_.transient_seconds = data.get<double>();
+    stats_.recording_seconds = data.get<double>();
+    y = data.getVec();
+
+    prepareBuffers();
+    prepareOutput(p);
+
+    const Index crossings = static_cast<Index>(data.get<std::int64_t>());
+    event_times_.resize(static_cast<std::size_t>(crossings));
+    event_states_.resize(static_cast<std::size_t>(crossings * dim));
+    event_ids_.resize(static_cast<std::size_t>(crossings));
+    data.getArray(event_times_.data(), crossings);
+    data.getArray(event_states_.data(), crossings * dim);
+    for (int& id : event_ids_) id = data.get<std::int32_t>();
+    terminated_ = false;
+
+    // Samples recorded before the checkpoint: held by the sink, or in the sample log
+    const bool streamed = data.get<std::uint8_t>() != 0;
+    if (streamed) {
+        if (!sink_) {
+            throw std::invalid_argument("Integrator::resume: checkpoint was written with a sink attached; attach a sink to resume it.");
+        }
+        sink_->resume(dim, p.sample_idx, data);
+    } else {
+        const Index stored = p.sample_idx;
+        Vec times(stored);
+        Mat states(dim, stored);
+        if (stored > 0) {
+            std::ifstream log(sampleLog(filename), std::ios::binary);
+            for (Index k = 0; k < stored && log; ++k) {
+                log.read(reinterpret_cast<char*>(&times(k)), sizeof(double));
+                log.read(reinterpret_cast<char*>(states.col(k).data()), sizeof(double) * dim);
+            }
+            if (!log) {
+                throw std::runtime_error("Integrator::resume: sample log " + sampleLog(filename) + " is missing or truncated.");
+            }
+        }
+        if (sink_) {
+            sink_->begin(dim);
+            if (stored > 0) sink_->consume(states, times);
+        } else {
+            results_.leftCols(stored) = states;
+            times_.head(stored) = times;
+        }
     }
 
-    if (num_samples > 0) {
-        results_.resize(dim, num_samples);
-        times_.resize(num_samples);
+    // Later checkpoints continue the sample log from the samples restored here
+    logged_samples_ = sink_ ? 0 : p.sample_idx;
+    if (checkpoint_every_ > 0 && !sink_) {
+        writer_->flush();
+        const std::string log = sampleLog(checkpoint_file_);
+        if (checkpoint_file_ == filename) {
+            // Drops samples appended after the checkpoint
+            resizeFile(log, sizeof(double) * static_cast<std::uint64_t>(dim + 1) * p.sample_idx);
+        } else {
+            resizeFile(log, 0);
+            appendToFile(log, sampleRecords(times_, results_, 0, logged_samples_));
+        }
     }
-    int sample_idx = 0;
 
-    // Transient phase
-    while (t < t_transient_) {
-        system_.rhs(t, y, k1_);
-        y_temp_.noalias() = y;
-        y_temp_.noalias() += dt_half * k1_;
-        system_.rhs(t + dt_half, y_temp_, k2_);
-        y_temp_.noalias() = y;
-        y_temp_.noalias() += dt_half * k2_;
-        system_.rhs(t + dt_half, y_temp_, k3_);
-        y_temp_.noalias() = y;
-        y_temp_.noalias() += dt_ * k3_;
-        system_.rhs(t + dt_, y_temp_, k4_);
-        y.noalias() += dt_sixth * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
-        t += dt_;
-    }
-
-    int max_steps = static_cast<int>(std::ceil((tf - t) / dt_));
+    run(y, p);
+}
 
-    // Main phase
-    while (sample_idx < num_samples) {
-        for (int step = 0; step < steps_per_sample && max_steps > 0; ++step, --max_steps) {
-            system_.rhs(t, y, k1_);
-            y_temp_.noalias() = y;
-            y_temp_.noalias() += dt_half * k1_;
-            system_.rhs(t + dt_half, y_temp_, k2_);
-            y_temp_.noalias() = y;
-            y_temp_.noalias() += dt_half * k2_;
-            system_.rhs(t + dt_half, y_temp_, k3_);
-            y_temp_.noalias() = y;
-            y_temp_.noalias() += dt_ * k3_;
-            system_.rhs(t + dt_, y_temp_, k4_);
-            y.noalias() += dt_sixth * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
-            t += dt_;
-        }
-        results_.col(sample_idx) = y;
-        times_(sample_idx) = t;
-        sample_idx++;
-        if (max_steps <= 0) break;
+bool Integrator::advance(Progress& p, Vec& y) {
+    if (!events_.empty()) {
+        return stepWithEvents(p.t, y);
     }
-    // Trim unused columns if we didn't fill all allocated slots
-    if (sample_idx < num_samples) {
-        results_.conservativeResize(Eigen::NoChange, sample_idx);
-        times_.conservativeResize(sample_idx);
+    step(p.t, y);
+    p.t += dt_;
+    return true;
+}
+
+void Integrator::checkpointIfDue(const Vec& y, const Progress& p) {
+    if (checkpoint_every_ > 0 && stats_.steps_taken % checkpoint_every_ == 0) {
+        writeCheckpoint(y, p);
     }
-    // std::cout << "Integration complete. Final state:\n" << y.transpose() << std::endl;
 }
 
-void Integrator::writeResultsToCSV(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
+void Integrator::writeCheckpoint(const Vec& y, const Progress& p) {
+    if (sink_) flushChunk();  // The sink has seen every sample up to the checkpoint
+
+    const int dim = system_.dim;
+    CheckpointData data(CheckpointKind::Integrator);
+    data.put(static_cast<std::int64_t>(dim));
+    data.put(dt_);
+    data.put(t_transient_);
+    data.put(output_interval_);
+    data.put(static_cast<std::int64_t>(events_.size()));
+    data.put(static_cast<std::int32_t>(method_));
+
+    data.put(p.t0);
+    data.put(p.tf);
+    data.put(p.t);
+    data.put(static_cast<std::uint8_t>(p.in_transient));
+    data.put(static_cast<std::int64_t>(p.num_samples));
+    data.put(static_cast<std::int64_t>(p.sample_idx));
+    data.put(static_cast<std::int32_t>(p.step_idx));
+    data.put(static_cast<std::int64_t>(p.max_steps));
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_start_).count();
+    data.put(stats_.rhs_evaluations);
+    data.put(stats_.steps_taken);
+    data.put(stats_.steps_rejected);
+    data.put(stats_.jacobian_evaluations);
+    data.put(stats_.factorizations);
+    data.put(stats_.transient_seconds + (p.in_transient ? elapsed : 0.0));
+    data.put(stats_.recording_seconds + (p.in_transient ? 0.0 : elapsed));
+    data.putVec(y);
+
+    data.put(static_cast<std::int64_t>(event_times_.size()));
+    data.putArray(event_times_.data(), static_cast<Index>(event_times_.size()));
+    data.putArray(event_states_.data(), static_cast<Index>(event_states_.size()));
+    for (int id : event_ids_) data.put(static_cast<std::int32_t>(id));
+
+    // Recorded samples: the sink saves its own state; otherwise only the samples since the
+    // last checkpoint are appended to the sample log, ahead of the checkpoint itself
+    data.put(static_cast<std::uint8_t>(sink_ != nullptr));
+    if (sink_) {
+        sink_->saveState(data);
+    } else if (p.sample_idx > logged_samples_) {
+        writer_->append(sampleLog(checkpoint_file_), sampleRecords(times_, results_, logged_samples_, p.sample_idx));
+        logged_samples_ = p.sample_idx;
+    }
+
+    writer_->submit(checkpoint_file_, data.serialize());
+}
+
+void Integrator::run(Vec& y, Progress& p) {
+    int steps_per_sample = 0;
+    if (output_interval_ > 0.0) {
+        steps_per_sample = static_cast<int>(std::round(output_interval_ / dt_));
+        if (steps_per_sample <= 0) steps_per_sample = 1;
     }
+    phase_start_ = std::chrono::steady_clock::now();
+    force_valid_ = false;  // y may have been changed since the last step
+
+    // Transient phase
+    if (p.in_transient) {
+        while (p.t < t_transient_) {
+            step(p.t, y);
+            p.t += dt_;
+            checkpointIfDue(y, p);
+        }
+        p.in_transient = false;
+        p.max_steps = static_cast<long long>(std::ceil((p.tf - p.t) / dt_));
 
-    // Set scientific format with high precision
-    file << std::scientific << std::setprecision(15);
+        // Exact sample count, now that the main-phase steps are known: results are sized
+        // once, so repeated runs reuse their storage instead of trimming it afterwards
+        if (p.num_samples > 0) {
+            const Index samples = (p.max_steps > 0) ? (p.max_steps + steps_per_sample - 1) / steps_per_sample : 1;
+            p.num_samples = std::min(p.num_samples, samples);
+            if (!sink_) {
+                results_.resize(system_.dim, p.num_samples);  // No-op when the size is unchanged
+                times_.resize(p.num_samples);
+            }
+        }
 
-    // Write header
-    file << "time";
-    for (int i = 0; i < results_.rows(); ++i) {
-        file << ",state_" << i;
+        auto recording_start = std::chrono::steady_clock::now();
+        stats_.transient_seconds += std::chrono::duration<double>(recording_start - phase_start_).count();
+        phase_start_ = recording_start;
     }
-    file << "\n";
 
-    // Write data
-    for (int col = 0; col < results_.cols(); ++col) {
-        file << times_(col);
-        for (int row = 0; row < results_.rows(); ++row) {
-            file << "," << results_(row, col);
+    // Events are only tracked in the main phase
+    if (!events_.empty()) {
+        g_prev_.resize(static_cast<Index>(events_.size()));
+        for (std::size_t i = 0; i < events_.size(); ++i) {
+            g_prev_(i) = events_[i].g(p.t, y);
         }
-        file << "\n";
     }
 
-    file.close();
-}
\ No newline at end of file
+    // Main phase
+    while (p.sample_idx < p.num_samples) {
+        while (p.step_idx < steps_per_sample && p.max_steps > 0) {
+            if (!advance(p, y)) break;
+            ++p.step_idx;
+            --p.max_steps;
+            checkpointIfDue(y, p);
+        }
+        if (terminated_) break;
+        recordSample(p.sample_idx, p.t, y);
+        p.sample_idx++;
+        p.step_idx = 0;
+        if (p.max_steps <= 0) break;
+    }
+    // Without output recording the state is still advanced to tf
+    if (p.num_samples == 0) {
+        while (p.max_steps > 0) {
+            if (!advance(p, y)) break;
+            --p.max_steps;
+            checkpointIfDue(y, p);
+        }
+    }
+    t_final_ = p.t;
+    stats_.recording_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_start_).count();
+    if (sink_) {
+        flushChunk();
+        sink_->end();
+    } else if (p.sample_idx < p.num_samples) {
+        // Trim unused columns if we didn't fill all allocated slots
+        results_.conservativeResize(Eigen::NoChange, p.sample_idx);
+        times_.conservativeResize(p.sample_idx);
+    }
+    if (writer_) writer_->flush();  // Surface errors of the last checkpoint write
+}
+
+void Integrator::writeResultsToCSV(const std::string& filename) const {
+    writeTrajectoryCSV(filename, times_, results_);
+}
+
+void Integrator::writeResultsToBinary(const std::string& filename, const TrajectoryMetadata& metadata) const {
+    // Integration settings are recorded next to any user-supplied metadata
+    TrajectoryMetadata full = metadata;
+    full.values.emplace("dt", dt_);
+    full.values.emplace("transient_time", t_transient_);
+    full.values.emplace("output_interval", output_interval_);
+    writeTrajectoryBinary(filename, times_, results_, full);
+}
@@ -0,0 +1,130 @@
+#include "LyapunovSpectrum.hpp"
+#include "Integrator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // System extended by k tangent vectors: state = [y; vec(Q)], Q is dim × k (column-major)
+    class VariationalSystem : public AbstractDynamicalSystem {
+    public:
+        VariationalSystem(AbstractDynamicalSystem& system, int num_vectors)
+            : system_(system), n_(system.dim), k_(num_vectors),
+              x_(system.dim), f_(system.dim), J_(system.dim, system.dim) {
+            dim = n_ + n_ * k_;
+        }
+
+        void rhs(double t, const Vec& y, Vec& dydt) override {
+            x_ = y.head(n_);
+            system_.rhs(t, x_, f_);
+            system_.jacobianWithRhs(t, x_, f_, J_);  // Reuses f_ for finite differences
+            dydt.head(n_) = f_;
+            Eigen::Map<const Mat> Q(y.data() + n_, n_, k_);
+            Eigen::Map<Mat> dQ(dydt.data() + n_, n_, k_);
+            dQ.noalias() = J_ * Q;
+        }
+
+    private:
+        AbstractDynamicalSystem& system_;
+        int n_;
+        int k_;
+        Vec x_, f_;  // Base state and its derivative
+        Mat J_;      // Jacobian at the base state
+    };
+
+    // Modified Gram–Schmidt on the columns of Q in place; adds log of each norm to log_sum
+    void orthonormalize(Eigen::Map<Mat>& Q, Vec& log_sum) {
+        for (Index j = 0; j < Q.cols(); ++j) {
+            for (Index i = 0; i < j; ++i) {
+                Q.col(j) -= Q.col(i).dot(Q.col(j)) * Q.col(i);
+            }
+            double norm = Q.col(j).norm();
+            if (norm <= 0.0 || !std::isfinite(norm)) {
+                throw std::runtime_error("LyapunovSpectrum: tangent vectors became degenerate; reduce the reorthonormalization interval.");
+            }
+            Q.col(j) /= norm;
+            log_sum(j) += std::log(norm);
+        }
+    }
+}
+
+LyapunovSpectrum::LyapunovSpectrum(AbstractDynamicalSystem& system, double dt)
+    : system_(system), dt_(dt) {}
+
+void LyapunovSpectrum::setTransientTime(double t_transient) {
+    t_transient_ = t_transient;
+}
+
+void LyapunovSpectrum::setReorthonormalizationInterval(double interval) {
+    if (interval <= 0.0) {
+        throw std::invalid_argument("LyapunovSpectrum::setReorthonormalizationInterval: interval must be positive.");
+    }
+    interval_ = interval;
+}
+
+void LyapunovSpectrum::setNumExponents(int num_exponents) {
+    num_exponents_ = num_exponents;
+}
+
+const Vec& LyapunovSpectrum::getExponents() const {
+    return exponents_;
+}
+
+const Vec& LyapunovSpectrum::compute(Vec& y, double t0, double tf) {
+    const int n = system_.dim;
+    if (n == 0) {
+        throw std::invalid_argument("LyapunovSpectrum::compute: system dimension (dim) must be set and positive.");
+    }
+    if (y.size() != n) {
+        throw std::invalid_argument("LyapunovSpectrum::compute: input vector y size does not match system dimension.");
+    }
+    const int k = (num_exponents_ > 0) ? num_exponents_ : n;
+    if (k > n) {
+        throw std::invalid_argument("LyapunovSpectrum::compute: more exponents requested than the system dimension.");
+    }
+
+    // Transient phase on the system alone
+    double t = t0;
+    if (t < t_transient_) {
+        Integrator transient(system_, dt_);
+        transient.integrate(y, t, t_transient_);
+        t = transient.getFinalTime();
+    }
+
+    VariationalSystem variational(system_, k);
+    Vec y_ext(variational.dim);
+    y_ext.head(n) = y;
+    Eigen::Map<Mat> Q(y_ext.data() + n, n, k);
+    Q.setIdentity();
+
+    Integrator integrator(variational, dt_);
+    Vec log_sum = Vec::Zero(k);
+    const double t_start = t;
+    const double t_eps = 1e-12 * std::max(1.0, std::abs(tf));
+
+    while (t < tf - t_eps) {
+        integrator.integrate(y_ext, t, std::min(t + interval_, tf));
+        t = integrator.getFinalTime();
+        orthonormalize(Q, log_sum);
+    }
+
+    y = y_ext.head(n);
+    if (t > t_start) {
+        exponents_ = log_sum / (t - t_start);
+    } else {
+        exponents_ = Vec::Zero(k);
+    }
+    return exponents_;
+}
+
+ParameterSweep::PointFunc LyapunovSpectrum::sweepFunction(double dt, double t_transient,
+                                                          double interval, int num_exponents) {
+    return [=](AbstractDynamicalSystem& system, const Vec& y0, double t0, double tf) {
+        LyapunovSpectrum spectrum(system, dt);
+        spectrum.setTransientTime(t_transient);
+        spectrum.setReorthonormalizationInterval(interval);
+        spectrum.setNumExponents(num_exponents);
+        Vec y = y0;
+        return Vec(spectrum.compute(y, t0, tf));
+    };
+}
@@ -1,7 +1,15 @@
 #include "ParameterSweep.hpp"
+#include "EnsembleIntegrator.hpp"
+#include "ThreadPool.hpp"
+#include "TrajectoryIO.hpp"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
 
 ParameterSweep::ParameterSweep(AbstractDynamicalSystem& system, const std::string& param_name)
     : system_(system), param_name_(param_name) {}
@@ -18,45 +26,539 @@ void ParameterSweep::setParameterRange(double start, double end, int num_steps)
     }
 }
 
+void ParameterSweep::setTimeStep(double dt) {
+    dt_ = dt;
+}
+
 void ParameterSweep::setTransientTime(double transient_time) {
     transient_time_ = transient_time;
 }
 
+void ParameterSweep::setOutputInterval(double interval) {
+    output_interval_ = interval;
+}
+
 void ParameterSweep::setPostProcessingFunction(PostProcessFunc func) {
     post_process_ = func;
 }
 
+void ParameterSweep::setPointFunction(PointFunc func) {
+    point_func_ = func;
+}
+
+void ParameterSweep::setBatchPostProcessingFunction(BatchPostProcessFunc func, Index batch_size) {
+    if (batch_size <= 0) {
+        throw std::invalid_argument("ParameterSweep::setBatchPostProcessingFunction: batch size must be positive.");
+    }
+    batch_post_process_ = func;
+    batch_size_ = batch_size;
+}
+
+void ParameterSweep::setReducer(const Reducer& reducer, int chunk_size) {
+    if (chunk_size <= 0) {
+        throw std::invalid_argument("ParameterSweep::setReducer: chunk size must be positive.");
+    }
+    reducer_ = reducer.clone();
+    reducer_chunk_ = chunk_size;
+}
+
+void ParameterSweep::setNumThreads(int num_threads) {
+    num_threads_ = num_threads;
+}
+
+void ParameterSweep::setBackend(Backend backend, Index block_size) {
+    if (block_size <= 0) {
+        throw std::invalid_argument("ParameterSweep::setBackend: block size must be positive.");
+    }
+    backend_ = backend;
+    block_size_ = block_size;
+}
+
+std::unique_ptr<SweepWorkspace> ParameterSweep::makeWorkspace(AbstractDynamicalSystem& system) const {
+    auto workspace = std::make_unique<SweepWorkspace>(system, dt_, transient_time_, output_interval_);
+    if (reducer_ && !point_func_) {
+        workspace->setReducer(reducer_->clone(), reducer_chunk_);
+    }
+    return workspace;
+}
+
+Vec ParameterSweep::evaluatePoint(SweepWorkspace& workspace, ParamHandle param, double param_value,
+                                  const Vec& y0, double t0, double tf) const {
+    workspace.system.setResolvedParameter(param, param_name_, param_value);
+    if (point_func_) {
+        return point_func_(workspace.system, y0, t0, tf);
+    }
+    if (workspace.reducer) {
+        return workspace.reduce(y0, t0, tf);
+    }
+    return post_process_(workspace.integrate(y0, t0, tf));
+}
+
+void ParameterSweep::setContinuation(Continuation mode, double tolerance, double window) {
+    if (tolerance <= 0.0 || window < 0.0) {
+        throw std::invalid_argument("ParameterSweep::setContinuation: tolerance must be positive and window non-negative.");
+    }
+    continuation_ = mode;
+    continuation_tol_ = tolerance;
+    continuation_window_ = window;
+}
+
+void ParameterSweep::setCheckpoint(const std::string& filename, int every_points) {
+    if (!filename.empty() && every_points <= 0) {
+        throw std::invalid_argument("ParameterSweep::setCheckpoint: checkpoint interval must be positive.");
+    }
+    checkpoint_file_ = filename;
+    checkpoint_every_ = filename.empty() ? 0 : every_points;
+    if (checkpoint_every_ > 0 && !writer_) {
+        writer_ = std::make_unique<CheckpointWriter>();
+    }
+}
+
 void ParameterSweep::runSweep(const Vec& y0, double t0, double tf) {
-    if (!post_process_) {
+    if (!post_process_ && !point_func_ && !batch_post_process_ && !reducer_) {
+        std::cerr << "Post-processing function is not set!" << std::endl;
+        return;
+    }
+
+    Index num_params = static_cast<Index>(param_values_.size());
+    processed_results_.resize(0, num_params);
+    backward_results_.resize(0, 0);
+    done_.assign(static_cast<std::size_t>(num_params), 0);
+    if (continuation_ != Continuation::Off) {
+        runContinuationSweep(y0, t0, tf);
+        return;
+    }
+    runPending(y0, t0, tf);
+}
+
+void ParameterSweep::resumeSweep(const Vec& y0, double t0, double tf) {
+    if (!post_process_ && !point_func_ && !batch_post_process_ && !reducer_) {
         std::cerr << "Post-processing function is not set!" << std::endl;
         return;
     }
+    if (checkpoint_file_.empty()) {
+        throw std::invalid_argument("ParameterSweep::resumeSweep: no checkpoint file set.");
+    }
+    if (continuation_ != Continuation::Off) {
+        throw std::invalid_argument("ParameterSweep::resumeSweep: continuation sweeps cannot be checkpointed.");
+    }
+
+    if (writer_) writer_->flush();  // A checkpoint of this object may still be in flight
+    CheckpointData data = CheckpointData::load(checkpoint_file_, CheckpointKind::ParameterSweep);
+    const Index num_params = static_cast<Index>(data.get<std::int64_t>());
+    std::vector<double> values(static_cast<std::size_t>(num_params));
+    data.getArray(values.data(), num_params);
+    const double dt = data.get<double>();
+    const double transient_time = data.get<double>();
+    const double output_interval = data.get<double>();
+    const auto backend = static_cast<Backend>(data.get<std::int32_t>());
+    const Index block_size = static_cast<Index>(data.get<std::int64_t>());
+    if (values != param_values_ || dt != dt_ || transient_time != transient_time_
+        || output_interval != output_interval_ || backend != backend_
+        || (backend_ == Backend::Ensemble && block_size != block_size_)) {
+        throw std::invalid_argument("ParameterSweep::resumeSweep: sweep settings differ from the checkpointed sweep.");
+    }
+
+    done_.resize(static_cast<std::size_t>(num_params));
+    for (auto& flag : done_) flag = data.get<std::uint8_t>();
+    processed_results_ = data.getMat();
+    if (processed_results_.cols() != num_params) {
+        throw std::runtime_error("ParameterSweep::resumeSweep: corrupted checkpoint " + checkpoint_file_);
+    }
+    runPending(y0, t0, tf);
+}
+
+void ParameterSweep::runPending(const Vec& y0, double t0, double tf) {
+    const auto start = std::chrono::steady_clock::now();
+    const Index pending = static_cast<Index>(std::count(done_.begin(), done_.end(), 0));
+    fresh_points_.clear();
+    saved_results_ = processed_results_;  // Restored points are already in the checkpoint
+    saved_done_ = done_;
+    if (backend_ == Backend::Ensemble) {
+        runEnsembleSweep(y0, t0, tf);
+    } else {
+        runScalarSweep(y0, t0, tf);
+    }
+
+    stats_ = SweepStats();
+    stats_.points = pending;
+    stats_.transient_time_nominal = pending * std::max(0.0, transient_time_ - t0);
+    stats_.transient_time_used = stats_.transient_time_nominal;
+    stats_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (writer_ && checkpoint_every_ > 0) {
+        saveCheckpoint(fresh_points_);
+        fresh_points_.clear();
+        writer_->flush();
+    }
+}
 
-    int num_params = static_cast<int>(param_values_.size());
-    std::vector<Vec> all_results;
+void ParameterSweep::store(Index i, const Vec& processed) {
+    if (processed.size() != processed_results_.rows()) {
+        throw std::runtime_error("ParameterSweep::runSweep: post-processing returned results of varying size.");
+    }
+    processed_results_.col(i) = processed;  // Each column has a single writer
+    done_[static_cast<std::size_t>(i)] = 1;
+    if (checkpoint_every_ <= 0) return;
 
-    for (double param_value : param_values_) {
-        system_.setParameter(param_name_, param_value);
+    std::vector<Index> points;
+    {
+        std::lock_guard<std::mutex> lock(progress_mutex_);
+        fresh_points_.push_back(i);
+        if (static_cast<int>(fresh_points_.size()) < checkpoint_every_) return;
+        points.swap(fresh_points_);
+    }
+    saveCheckpoint(points);
+}
 
-        Integrator integrator(system_, /* dt = */ 0.01);  // You can expose dt as configurable if needed
-        integrator.setTransientTime(transient_time_);
+void ParameterSweep::saveCheckpoint(const std::vector<Index>& points) {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    const Index num_params = static_cast<Index>(param_values_.size());
+    if (saved_results_.rows() != processed_results_.rows()) {
+        saved_results_.setZero(processed_results_.rows(), num_params);  // Result size fixed by the first point
+    }
+    // The workers published these columns under progress_mutex_ before handing them over
+    for (Index i : points) {
+        saved_results_.col(i) = processed_results_.col(i);
+        saved_done_[static_cast<std::size_t>(i)] = 1;
+    }
 
-        Vec y_copy = y0;
-        integrator.integrate(y_copy, t0, tf);
-        const Mat& result = integrator.getResults();
+    CheckpointData data(CheckpointKind::ParameterSweep);
+    data.put(static_cast<std::int64_t>(num_params));
+    data.putArray(param_values_.data(), num_params);
+    data.put(dt_);
+    data.put(transient_time_);
+    data.put(output_interval_);
+    data.put(static_cast<std::int32_t>(backend_));
+    data.put(static_cast<std::int64_t>(block_size_));
+    for (std::uint8_t flag : saved_done_) data.put(flag);
+    data.putMat(saved_results_);
+    writer_->submit(checkpoint_file_, data.serialize());
+}
 
-        Vec processed = post_process_(result);
-        all_results.push_back(processed);
+void ParameterSweep::runScalarSweep(const Vec& y0, double t0, double tf) {
+    Index num_params = static_cast<Index>(param_values_.size());
+    std::vector<Index> pending;
+    for (Index i = 0; i < num_params; ++i) {
+        if (!done_[static_cast<std::size_t>(i)]) pending.push_back(i);
     }
+    if (pending.empty()) return;
 
-    // Store as a matrix: each column is the processed result for a parameter value
-    if (!all_results.empty()) {
-        int result_dim = static_cast<int>(all_results[0].rows());
-        processed_results_.resize(result_dim, num_params);
-        for (int i = 0; i < num_params; ++i) {
-            processed_results_.col(i) = all_results[i];
+    if (batch_post_process_ && !point_func_) {
+        runBatchedSweep(pending, y0, t0, tf);
+        return;
+    }
+
+    // The parameter name is resolved once; clones share the handle
+    const ParamHandle param = system_.resolveParameter(param_name_);
+
+    // The first point fixes the size of the processed result (unless restored from a
+    // checkpoint); every later point is written straight into its own column.
+    std::unique_ptr<SweepWorkspace> own = makeWorkspace(system_);
+    SweepWorkspace& workspace = *own;
+    std::size_t next = 0;
+    if (static_cast<Index>(pending.size()) == num_params) {
+        Vec first = evaluatePoint(workspace, param, param_values_[pending[0]], y0, t0, tf);
+        processed_results_.resize(first.size(), num_params);
+        store(pending[0], first);
+        next = 1;
+    }
+
+    if (num_threads_ == 1) {
+        for (std::size_t k = next; k < pending.size(); ++k) {
+            Index i = pending[k];
+            store(i, evaluatePoint(workspace, param, param_values_[i], y0, t0, tf));
         }
+        return;
+    }
+
+    ThreadPool pool(num_threads_);
+    std::vector<std::unique_ptr<AbstractDynamicalSystem>> systems;
+    std::vector<std::unique_ptr<SweepWorkspace>> workspaces;
+    for (int w = 0; w < pool.size(); ++w) {
+        systems.push_back(system_.clone());
+        workspaces.push_back(makeWorkspace(*systems.back()));
     }
+
+    // Each point starts from y0 on a private system copy, so the result of a column
+    // does not depend on which worker computed it or in which order.
+    pool.parallelFor(static_cast<Index>(pending.size() - next), [&](Index k, int worker) {
+        Index i = pending[next + static_cast<std::size_t>(k)];
+        store(i, evaluatePoint(*workspaces[worker], param, param_values_[i], y0, t0, tf));
+    });
+}
+
+void ParameterSweep::runBatchedSweep(const std::vector<Index>& pending, const Vec& y0, double t0, double tf) {
+    const Index num_params = static_cast<Index>(param_values_.size());
+    const ParamHandle param = system_.resolveParameter(param_name_);
+    const Index dim = system_.dim;
+
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::unique_ptr<AbstractDynamicalSystem>> systems;
+    std::vector<std::unique_ptr<SweepWorkspace>> workspaces;
+    if (num_threads_ == 1) {
+        workspaces.push_back(std::make_unique<SweepWorkspace>(system_, dt_, transient_time_, output_interval_));
+    } else {
+        pool = std::make_unique<ThreadPool>(num_threads_);
+        for (int w = 0; w < pool->size(); ++w) {
+            systems.push_back(system_.clone());
+            workspaces.push_back(std::make_unique<SweepWorkspace>(*systems.back(), dt_, transient_time_, output_interval_));
+        }
+    }
+
+    // Every point records the same number of samples; the first one tells how many
+    Index num_samples = -1;
+    Mat trajectories;
+    auto integrate_into = [&](Index j, Index i, SweepWorkspace& workspace) {
+        workspace.system.setResolvedParameter(param, param_name_, param_values_[i]);
+        const Mat& result = workspace.integrate(y0, t0, tf);
+        if (result.cols() != num_samples) {
+            throw std::runtime_error("ParameterSweep::runSweep: points recorded different numbers of samples.");
+        }
+        trajectories.middleCols(j * num_samples, num_samples) = result;
+    };
+
+    const Index total = static_cast<Index>(pending.size());
+    for (Index first = 0; first < total; first += batch_size_) {
+        const Index count = std::min(batch_size_, total - first);
+        Index next = 0;
+        if (num_samples < 0) {
+            SweepWorkspace& workspace = *workspaces[0];
+            workspace.system.setResolvedParameter(param, param_name_, param_values_[pending[static_cast<std::size_t>(first)]]);
+            const Mat& result = workspace.integrate(y0, t0, tf);
+            num_samples = result.cols();
+            trajectories.resize(dim, num_samples * count);
+            trajectories.leftCols(num_samples) = result;
+            next = 1;
+        }
+        trajectories.resize(dim, num_samples * count);  // No-op except for a shorter last batch
+        if (pool) {
+            pool->parallelFor(count - next, [&](Index k, int worker) {
+                integrate_into(next + k, pending[static_cast<std::size_t>(first + next + k)], *workspaces[worker]);
+            });
+        } else {
+            for (Index k = next; k < count; ++k) {
+                integrate_into(k, pending[static_cast<std::size_t>(first + k)], *workspaces[0]);
+            }
+        }
+
+        const Mat processed = batch_post_process_(trajectories, count);
+        if (processed.cols() != count) {
+            throw std::runtime_error("ParameterSweep::runSweep: batch post-processing returned the wrong number of points.");
+        }
+        if (processed_results_.rows() == 0 && processed_results_.cols() == num_params) {
+            processed_results_.resize(processed.rows(), num_params);
+        }
+        for (Index k = 0; k < count; ++k) {
+            store(pending[static_cast<std::size_t>(first + k)], processed.col(k));
+        }
+    }
+}
+
+void ParameterSweep::runEnsembleSweep(const Vec& y0, double t0, double tf) {
+    if (!system_.hasBatchRhs()) {
+        throw std::invalid_argument("ParameterSweep::runSweep: ensemble backend requires a system with rhsBatch().");
+    }
+    if (point_func_ || batch_post_process_ || reducer_ || !post_process_) {
+        throw std::invalid_argument("ParameterSweep::runSweep: ensemble backend requires a post-processing function.");
+    }
+    if (y0.size() != system_.dim) {
+        throw std::invalid_argument("ParameterSweep::runSweep: y0 size does not match system dimension.");
+    }
+
+    Index num_params = static_cast<Index>(param_values_.size());
+    if (num_params == 0) return;
+
+    // Blocks keep their composition across resumes, so a block is recomputed as a whole
+    // whenever one of its points is missing
+    Index num_blocks = (num_params + block_size_ - 1) / block_size_;
+    std::vector<Index> pending;
+    for (Index block = 0; block < num_blocks; ++block) {
+        Index first = block * block_size_;
+        Index last = std::min(first + block_size_, num_params);
+        if (std::find(done_.begin() + first, done_.begin() + last, 0) != done_.begin() + last) {
+            pending.push_back(block);
+        }
+    }
+    if (pending.empty()) return;
+    const bool sized = std::find(done_.begin(), done_.end(), 1) != done_.end();
+
+    ThreadPool pool(num_threads_);
+    // One ensemble integrator and state block per worker, reused for all of its blocks
+    std::vector<std::unique_ptr<AbstractDynamicalSystem>> systems;
+    std::vector<std::unique_ptr<EnsembleIntegrator>> integrators;
+    std::vector<BatchMat> states(static_cast<std::size_t>(pool.size()));
+    for (int w = 0; w < pool.size(); ++w) {
+        AbstractDynamicalSystem* system = &system_;
+        if (pool.size() > 1) {
+            systems.push_back(system_.clone());
+            system = systems.back().get();
+        }
+        integrators.push_back(std::make_unique<EnsembleIntegrator>(*system, dt_));
+        integrators.back()->setTransientTime(transient_time_);
+        integrators.back()->setOutputInterval(output_interval_);
+    }
+
+    // Integrates one block of consecutive parameter points as a single ensemble
+    auto run_block = [&](Index block, int worker, bool size_results) {
+        Index first = block * block_size_;
+        Index members = std::min(block_size_, num_params - first);
+        AbstractDynamicalSystem& system = systems.empty() ? system_ : *systems[worker];
+
+        Arr values = Eigen::Map<const Arr>(param_values_.data() + first, members);
+        system.setParameterBatch(param_name_, values);
+
+        EnsembleIntegrator& integrator = *integrators[worker];
+        BatchMat& Y = states[static_cast<std::size_t>(worker)];
+        Y = y0.replicate(1, members);
+        integrator.integrate(Y, t0, tf);
+        system.setParameterBatch(param_name_, Arr());  // Later runs on this system must not see the block's values
+
+        for (Index m = 0; m < members; ++m) {
+            Vec processed = post_process_(integrator.getMemberResults(m));
+            if (size_results && m == 0) {
+                processed_results_.resize(processed.size(), num_params);
+            }
+            store(first + m, processed);
+        }
+    };
+
+    // The first block fixes the size of the processed result
+    std::size_t next = 0;
+    if (!sized) {
+        run_block(pending[0], 0, true);
+        next = 1;
+    }
+    pool.parallelFor(static_cast<Index>(pending.size() - next), [&](Index k, int worker) {
+        run_block(pending[next + static_cast<std::size_t>(k)], worker, false);
+    });
+}
+
+void ParameterSweep::runContinuationSweep(const Vec& y0, double t0, double tf) {
+    if (point_func_ || batch_post_process_ || reducer_ || !post_process_) {
+        throw std::invalid_argument("ParameterSweep::runSweep: continuation requires a post-processing function.");
+    }
+    if (backend_ != Backend::Scalar) {
+        throw std::invalid_argument("ParameterSweep::runSweep: continuation requires the scalar backend.");
+    }
+    if (checkpoint_every_ > 0) {
+        throw std::invalid_argument("ParameterSweep::runSweep: continuation sweeps cannot be checkpointed.");
+    }
+    if (y0.size() != system_.dim) {
+        throw std::invalid_argument("ParameterSweep::runSweep: y0 size does not match system dimension.");
+    }
+    if (param_values_.empty()) return;
+
+    const auto start = std::chrono::steady_clock::now();
+    stats_ = SweepStats();
+    if (continuation_ != Continuation::Both) {
+        continuationPass(system_, continuation_ == Continuation::Backward, y0, t0, tf, processed_results_, stats_);
+    } else {
+        // The directions are independent; with threads the backward pass runs on a clone
+        SweepStats backward_stats;
+        if (num_threads_ == 1) {
+            continuationPass(system_, false, y0, t0, tf, processed_results_, stats_);
+            continuationPass(system_, true, y0, t0, tf, backward_results_, backward_stats);
+        } else {
+            std::unique_ptr<AbstractDynamicalSystem> backward_system = system_.clone();
+            ThreadPool pool(2);
+            pool.parallelFor(2, [&](Index pass, int) {
+                if (pass == 0) {
+                    continuationPass(system_, false, y0, t0, tf, processed_results_, stats_);
+                } else {
+                    continuationPass(*backward_system, true, y0, t0, tf, backward_results_, backward_stats);
+                }
+            });
+        }
+        stats_.points += backward_stats.points;
+        stats_.warm_started += backward_stats.warm_started;
+        stats_.converged_early += backward_stats.converged_early;
+        stats_.transient_time_nominal += backward_stats.transient_time_nominal;
+        stats_.transient_time_used += backward_stats.transient_time_used;
+    }
+    std::fill(done_.begin(), done_.end(), 1);
+    stats_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ParameterSweep::continuationPass(AbstractDynamicalSystem& system, bool backward, const Vec& y0,
+                                      double t0, double tf, Mat& results, SweepStats& stats) const {
+    const Index num_params = static_cast<Index>(param_values_.size());
+    const ParamHandle param = system.resolveParameter(param_name_);
+    const double nominal = std::max(0.0, transient_time_ - t0);
+    const double record_time = tf - std::max(t0, transient_time_);
+
+    // Both integrators keep their buffers across the points of the pass
+    Integrator integrator(system, dt_);
+    integrator.setOutputInterval(output_interval_);
+    Integrator window_integrator(system, dt_);
+    window_integrator.setOutputInterval(dt_);
+
+    Vec y = y0;
+    for (Index k = 0; k < num_params; ++k) {
+        const Index i = backward ? num_params - 1 - k : k;
+        system.setResolvedParameter(param, param_name_, param_values_[i]);
+
+        if (k == 0) {
+            // Cold start: identical to a point of a regular sweep
+            y = y0;
+            integrator.setTransientTime(transient_time_);
+            integrator.integrate(y, t0, tf);
+            stats.transient_time_used += nominal;
+        } else {
+            double t = t0;
+            bool converged = false;
+            stats.transient_time_used += warmTransient(window_integrator, y, t, nominal, converged);
+            ++stats.warm_started;
+            if (converged) ++stats.converged_early;
+            integrator.setTransientTime(t);
+            integrator.integrate(y, t, t + record_time);
+        }
+        stats.transient_time_nominal += nominal;
+        ++stats.points;
+
+        Vec processed = post_process_(integrator.getResults());
+        if (k == 0) {
+            results.resize(processed.size(), num_params);
+        } else if (processed.size() != results.rows()) {
+            throw std::runtime_error("ParameterSweep::runSweep: post-processing returned results of varying size.");
+        }
+        results.col(i) = processed;
+    }
+}
+
+double ParameterSweep::warmTransient(Integrator& integrator, Vec& y, double& t, double nominal,
+                                     bool& converged) const {
+    const double window = (continuation_window_ > 0.0) ? continuation_window_ : nominal / 50.0;
+    converged = false;
+    if (nominal <= 0.0 || window <= 0.0) return 0.0;
+
+    // Every step of a window is recorded to build its per-component envelope
+    Vec env_min, env_max, prev_min, prev_max;
+    const double t_start = t;
+    double used = 0.0;
+    while (used < nominal - 0.5 * dt_) {
+        const double length = std::min(window, nominal - used);
+        integrator.setTransientTime(t);
+        integrator.integrate(y, t, t + length);
+        t = integrator.getFinalTime();
+        used = t - t_start;
+
+        const Mat& window_states = integrator.getResults();
+        if (window_states.cols() == 0) continue;
+        env_min = window_states.rowwise().minCoeff();
+        env_max = window_states.rowwise().maxCoeff();
+        if (prev_min.size() == env_min.size()) {
+            const double change = std::max((env_min - prev_min).cwiseAbs().maxCoeff(),
+                                           (env_max - prev_max).cwiseAbs().maxCoeff());
+            const double scale = std::max({1.0, env_min.cwiseAbs().maxCoeff(), env_max.cwiseAbs().maxCoeff()});
+            if (change <= continuation_tol_ * scale) {
+                converged = true;
+                break;
+            }
+        }
+        prev_min.swap(env_min);
+        prev_max.swap(env_max);
+    }
+    return used;
 }
 
 const std::vector<double>& ParameterSweep::getParameterValues() const {
@@ -67,6 +569,14 @@ const Mat& ParameterSweep::getProcessedResults() const {
     return processed_results_;
 }
 
+const Mat& ParameterSweep::getBackwardResults() const {
+    return backward_results_;
+}
+
+const ParameterSweep::SweepStats& ParameterSweep::getStats() const {
+    return stats_;
+}
+
 void ParameterSweep::writeResultsToCSV(const std::string& filename) const {
     std::ofstream file(filename);
     if (!file.is_open()) {
@@ -93,4 +603,14 @@ void ParameterSweep::writeResultsToCSV(const std::string& filename) const {
     }
 
     file.close();
-}
\ No newline at end of file
+}
+
+void ParameterSweep::writeResultsToBinary(const std::string& filename) const {
+    TrajectoryMetadata metadata;
+    metadata.abscissa_name = param_name_;
+    metadata.values["dt"] = dt_;
+    metadata.values["transient_time"] = transient_time_;
+    metadata.values["output_interval"] = output_interval_;
+    Vec values = Eigen::Map<const Vec>(param_values_.data(), static_cast<Index>(param_values_.size()));
+    writeTrajectoryBinary(filename, values, processed_results_, metadata);
+}
@@ -0,0 +1,425 @@
+#include "Reducer.hpp"
+#include "Checkpoint.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr double TWO_PI = 6.283185307179586;
+
+    void checkComponent(const char* reducer, int component, int dim) {
+        if (component < 0 || component >= dim) {
+            throw std::invalid_argument(std::string(reducer) + ": component " + std::to_string(component)
+                                        + " is outside the state of dimension " + std::to_string(dim) + ".");
+        }
+    }
+}
+
+void Reducer::begin(int dim) {
+    reset(dim);
+}
+
+void Reducer::resume(int dim, Index samples, CheckpointData& state) {
+    reset(dim);
+    loadState(state);
+}
+
+// ===================================================
+//               MinMaxReducer
+// ===================================================
+
+void MinMaxReducer::reset(int dim) {
+    min_.setConstant(dim, std::numeric_limits<double>::infinity());
+    max_.setConstant(dim, -std::numeric_limits<double>::infinity());
+}
+
+void MinMaxReducer::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    min_ = min_.cwiseMin(states.rowwise().minCoeff());
+    max_ = max_.cwiseMax(states.rowwise().maxCoeff());
+}
+
+Vec MinMaxReducer::result() const {
+    Vec out(2 * min_.size());
+    out << min_, max_;
+    return out;
+}
+
+void MinMaxReducer::saveState(CheckpointData& state) const {
+    state.putVec(min_);
+    state.putVec(max_);
+}
+
+void MinMaxReducer::loadState(CheckpointData& state) {
+    min_ = state.getVec();
+    max_ = state.getVec();
+}
+
+std::unique_ptr<Reducer> MinMaxReducer::clone() const {
+    return std::make_unique<MinMaxReducer>();
+}
+
+// ===================================================
+//               MeanVarianceReducer
+// ===================================================
+
+void MeanVarianceReducer::reset(int dim) {
+    count_ = 0;
+    mean_.setZero(dim);
+    m2_.setZero(dim);
+}
+
+void MeanVarianceReducer::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    const Index n = states.cols();
+    if (n == 0) return;
+    const Vec chunk_mean = states.rowwise().mean();
+    const Vec chunk_m2 = (states.colwise() - chunk_mean).rowwise().squaredNorm();
+
+    // Chan et al.: merge (count_, mean_, m2_) with the chunk's statistics
+    const Index total = count_ + n;
+    const Vec delta = chunk_mean - mean_;
+    mean_ += delta * (static_cast<double>(n) / total);
+    m2_ += chunk_m2 + delta.cwiseProduct(delta) * (static_cast<double>(count_) * n / total);
+    count_ = total;
+}
+
+Vec MeanVarianceReducer::result() const {
+    Vec out(2 * mean_.size());
+    out << mean_, (count_ > 0 ? Vec(m2_ / static_cast<double>(count_)) : Vec::Constant(m2_.size(), NaN));
+    return out;
+}
+
+void MeanVarianceReducer::saveState(CheckpointData& state) const {
+    state.put(static_cast<std::int64_t>(count_));
+    state.putVec(mean_);
+    state.putVec(m2_);
+}
+
+void MeanVarianceReducer::loadState(CheckpointData& state) {
+    count_ = static_cast<Index>(state.get<std::int64_t>());
+    mean_ = state.getVec();
+    m2_ = state.getVec();
+}
+
+std::unique_ptr<Reducer> MeanVarianceReducer::clone() const {
+    return std::make_unique<MeanVarianceReducer>();
+}
+
+// ===================================================
+//               PeakReducer
+// ===================================================
+
+PeakReducer::PeakReducer(int component) : component_(component) {}
+
+void PeakReducer::reset(int dim) {
+    checkComponent("PeakReducer", component_, dim);
+    seen_ = 0;
+    peaks_ = 0;
+    sum_ = 0.0;
+    min_ = std::numeric_limits<double>::infinity();
+    max_ = -std::numeric_limits<double>::infinity();
+}
+
+void PeakReducer::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    for (Index k = 0; k < states.cols(); ++k) {
+        const double x = states(component_, k);
+        if (seen_ >= 2 && prev1_ > prev2_ && prev1_ >= x) {
+            ++peaks_;
+            sum_ += prev1_;
+            min_ = std::min(min_, prev1_);
+            max_ = std::max(max_, prev1_);
+        }
+        prev2_ = prev1_;
+        prev1_ = x;
+        ++seen_;
+    }
+}
+
+Vec PeakReducer::result() const {
+    Vec out(4);
+    if (peaks_ == 0) {
+        out << 0.0, NaN, NaN, NaN;
+    } else {
+        out << static_cast<double>(peaks_), sum_ / peaks_, min_, max_;
+    }
+    return out;
+}
+
+void PeakReducer::saveState(CheckpointData& state) const {
+    state.put(static_cast<std::int64_t>(seen_));
+    state.put(prev2_);
+    state.put(prev1_);
+    state.put(static_cast<std::int64_t>(peaks_));
+    state.put(sum_);
+    state.put(min_);
+    state.put(max_);
+}
+
+void PeakReducer::loadState(CheckpointData& state) {
+    seen_ = static_cast<Index>(state.get<std::int64_t>());
+    prev2_ = state.get<double>();
+    prev1_ = state.get<double>();
+    peaks_ = static_cast<Index>(state.get<std::int64_t>());
+    sum_ = state.get<double>();
+    min_ = state.get<double>();
+    max_ = state.get<double>();
+}
+
+std::unique_ptr<Reducer> PeakReducer::clone() const {
+    return std::make_unique<PeakReducer>(component_);
+}
+
+// ===================================================
+//               PeriodReducer
+// ===================================================
+
+PeriodReducer::PeriodReducer(int component, double level) : component_(component), level_(level) {}
+
+void PeriodReducer::reset(int dim) {
+    checkComponent("PeriodReducer", component_, dim);
+    has_prev_ = false;
+    crossings_ = 0;
+    mean_period_ = 0.0;
+    m2_period_ = 0.0;
+}
+
+void PeriodReducer::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    for (Index k = 0; k < states.cols(); ++k) {
+        const double x = states(component_, k);
+        const double t = times(k);
+        if (has_prev_ && prev_value_ < level_ && x >= level_) {
+            const double crossing = prev_time_ + (level_ - prev_value_) / (x - prev_value_) * (t - prev_time_);
+            if (crossings_ > 0) {
+                // Welford update with the new interval
+                const double period = crossing - last_crossing_;
+                const double intervals = static_cast<double>(crossings_);
+                const double delta = period - mean_period_;
+                mean_period_ += delta / intervals;
+                m2_period_ += delta * (period - mean_period_);
+            }
+            last_crossing_ = crossing;
+            ++crossings_;
+        }
+        prev_value_ = x;
+        prev_time_ = t;
+        has_prev_ = true;
+    }
+}
+
+Vec PeriodReducer::result() const {
+    Vec out(3);
+    if (crossings_ < 2) {
+        out << NaN, NaN, static_cast<double>(crossings_);
+    } else {
+        out << mean_period_, std::sqrt(m2_period_ / static_cast<double>(crossings_ - 1)),
+               static_cast<double>(crossings_);
+    }
+    return out;
+}
+
+void PeriodReducer::saveState(CheckpointData& state) const {
+    state.put(static_cast<std::uint8_t>(has_prev_));
+    state.put(prev_value_);
+    state.put(prev_time_);
+    state.put(static_cast<std::int64_t>(crossings_));
+    state.put(last_crossing_);
+    state.put(mean_period_);
+    state.put(m2_period_);
+}
+
+void PeriodReducer::loadState(CheckpointData& state) {
+    has_prev_ = state.get<std::uint8_t>() != 0;
+    prev_value_ = state.get<double>();
+    prev_time_ = state.get<double>();
+    crossings_ = static_cast<Index>(state.get<std::int64_t>());
+    last_crossing_ = state.get<double>();
+    mean_period_ = state.get<double>();
+    m2_period_ = state.get<double>();
+}
+
+std::unique_ptr<Reducer> PeriodReducer::clone() const {
+    return std::make_unique<PeriodReducer>(component_, level_);
+}
+
+// ===================================================
+//               HistogramReducer
+// ===================================================
+
+HistogramReducer::HistogramReducer(int component, double lo, double hi, int bins)
+    : component_(component), lo_(lo), hi_(hi) {
+    if (bins <= 0 || !(hi > lo)) {
+        throw std::invalid_argument("HistogramReducer: need at least one bin and hi > lo.");
+    }
+    counts_.setZero(bins);
+}
+
+void HistogramReducer::reset(int dim) {
+    checkComponent("HistogramReducer", component_, dim);
+    counts_.setZero();
+}
+
+void HistogramReducer::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    const Index bins = counts_.size();
+    const double scale = bins / (hi_ - lo_);
+    for (Index k = 0; k < states.cols(); ++k) {
+        const double x = states(component_, k);
+        if (!(x >= lo_ && x < hi_)) continue;  // Also skips NaN
+        const Index bin = std::min(static_cast<Index>((x - lo_) * scale), bins - 1);
+        counts_(bin) += 1.0;
+    }
+}
+
+Vec HistogramReducer::result() const {
+    return counts_;
+}
+
+void HistogramReducer::saveState(CheckpointData& state) const {
+    state.putVec(counts_);
+}
+
+void HistogramReducer::loadState(CheckpointData& state) {
+    Vec counts = state.getVec();
+    if (counts.size() != counts_.size()) {
+        throw std::invalid_argument("HistogramReducer: bin count differs from the checkpointed run.");
+    }
+    counts_ = counts;
+}
+
+std::unique_ptr<Reducer> HistogramReducer::clone() const {
+    return std::make_unique<HistogramReducer>(component_, lo_, hi_, static_cast<int>(counts_.size()));
+}
+
+// ===================================================
+//               SpectralReducer
+// ===================================================
+
+SpectralReducer::SpectralReducer(int component, const std::vector<double>& frequencies)
+    : component_(component),
+      frequencies_(Eigen::Map<const Arr>(frequencies.data(), static_cast<Index>(frequencies.size()))) {
+    if (frequencies.empty()) {
+        throw std::invalid_argument("SpectralReducer: no frequencies given.");
+    }
+}
+
+void SpectralReducer::reset(int dim) {
+    checkComponent("SpectralReducer", component_, dim);
+    count_ = 0;
+    sums_.setZero(frequencies_.size());
+    phasors_.resize(frequencies_.size());
+    steps_.resize(frequencies_.size());
+}
+
+void SpectralReducer::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    const Index n = states.cols();
+    if (n == 0) return;
+
+    // Exact phase at the first sample; evenly spaced samples then advance by a fixed rotation
+    const Arr angle0 = -TWO_PI * times(0) * frequencies_;
+    phasors_.real() = angle0.cos();
+    phasors_.imag() = angle0.sin();
+    if (n > 1) {
+        const Arr step = -TWO_PI * ((times(n - 1) - times(0)) / (n - 1)) * frequencies_;
+        steps_.real() = step.cos();
+        steps_.imag() = step.sin();
+    }
+    for (Index k = 0; k < n; ++k) {
+        sums_ += states(component_, k) * phasors_;
+        phasors_ *= steps_;
+    }
+    count_ += n;
+}
+
+Vec SpectralReducer::result() const {
+    if (count_ == 0) return Vec::Constant(frequencies_.size(), NaN);
+    return (sums_.abs2() * (4.0 / (static_cast<double>(count_) * count_))).matrix();
+}
+
+void SpectralReducer::saveState(CheckpointData& state) const {
+    state.put(static_cast<std::int64_t>(count_));
+    state.putVec(sums_.real().matrix());
+    state.putVec(sums_.imag().matrix());
+}
+
+void SpectralReducer::loadState(CheckpointData& state) {
+    count_ = static_cast<Index>(state.get<std::int64_t>());
+    const Vec re = state.getVec();
+    const Vec im = state.getVec();
+    if (re.size() != frequencies_.size() || im.size() != frequencies_.size()) {
+        throw std::invalid_argument("SpectralReducer: frequencies differ from the checkpointed run.");
+    }
+    sums_.real() = re.array();
+    sums_.imag() = im.array();
+}
+
+std::unique_ptr<Reducer> SpectralReducer::clone() const {
+    std::vector<double> frequencies(frequencies_.data(), frequencies_.data() + frequencies_.size());
+    return std::make_unique<SpectralReducer>(component_, frequencies);
+}
+
+// ===================================================
+//               ReducerSet
+// ===================================================
+
+ReducerSet::ReducerSet(const ReducerSet& other) {
+    for (const auto& reducer : other.reducers_) reducers_.push_back(reducer->clone());
+}
+
+ReducerSet& ReducerSet::operator=(const ReducerSet& other) {
+    if (this != &other) {
+        reducers_.clear();
+        for (const auto& reducer : other.reducers_) reducers_.push_back(reducer->clone());
+    }
+    return *this;
+}
+
+ReducerSet& ReducerSet::add(const Reducer& reducer) {
+    reducers_.push_back(reducer.clone());
+    return *this;
+}
+
+void ReducerSet::reset(int dim) {
+    for (auto& reducer : reducers_) reducer->begin(dim);
+}
+
+void ReducerSet::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    for (auto& reducer : reducers_) reducer->consume(states, times);
+}
+
+void ReducerSet::end() {
+    for (auto& reducer : reducers_) reducer->end();
+}
+
+void ReducerSet::saveState(CheckpointData& state) const {
+    for (const auto& reducer : reducers_) reducer->saveState(state);
+}
+
+void ReducerSet::resume(int dim, Index samples, CheckpointData& state) {
+    for (auto& reducer : reducers_) reducer->resume(dim, samples, state);
+}
+
+void ReducerSet::loadState(CheckpointData& state) {
+    // Unused: resume() hands the state to each member, which knows its own layout
+}
+
+Vec ReducerSet::result() const {
+    std::vector<Vec> parts;
+    Index size = 0;
+    for (const auto& reducer : reducers_) {
+        parts.push_back(reducer->result());
+        size += parts.back().size();
+    }
+    Vec out(size);
+    Index offset = 0;
+    for (const Vec& part : parts) {
+        out.segment(offset, part.size()) = part;
+        offset += part.size();
+    }
+    return out;
+}
+
+std::unique_ptr<Reducer> ReducerSet::clone() const {
+    return std::make_unique<ReducerSet>(*this);
+}
@@ -0,0 +1,304 @@
+#include "ResultStore.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char MAGIC[8] = {'N', 'L', 'D', 'K', 'R', 'E', 'S', '\0'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint64_t ALIGNMENT = 64;
+
+    std::uint64_t alignUp(std::uint64_t bytes) {
+        return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    template <typename T>
+    void append(std::vector<char>& buffer, const T& value) {
+        const char* p = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    void writeAt(int fd, const void* data, std::size_t bytes, std::uint64_t offset, const std::string& filename) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t written = ::pwrite(fd, p, bytes, static_cast<off_t>(offset));
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed to write file: " + filename + ": " + std::strerror(errno));
+            }
+            p += written;
+            offset += static_cast<std::uint64_t>(written);
+            bytes -= static_cast<std::size_t>(written);
+        }
+    }
+
+    void readAt(int fd, void* data, std::size_t bytes, std::uint64_t offset, const std::string& filename) {
+        char* p = static_cast<char*>(data);
+        while (bytes > 0) {
+            ssize_t read = ::pread(fd, p, bytes, static_cast<off_t>(offset));
+            if (read < 0 && errno == EINTR) continue;
+            if (read <= 0) {
+                throw std::runtime_error("ResultStore: truncated store file " + filename);
+            }
+            p += read;
+            offset += static_cast<std::uint64_t>(read);
+            bytes -= static_cast<std::size_t>(read);
+        }
+    }
+}
+
+ResultStore::ResultStore() : mode_(Mode::Memory) {}
+
+ResultStore::ResultStore(const std::string& filename, Index chunk_points)
+    : mode_(Mode::Spill), filename_(filename), chunk_points_(chunk_points) {
+    if (chunk_points <= 0) {
+        throw std::invalid_argument("ResultStore: chunk size must be positive.");
+    }
+}
+
+ResultStore::~ResultStore() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+std::unique_ptr<ResultStore> ResultStore::open(const std::string& filename) {
+    std::unique_ptr<ResultStore> store(new ResultStore());
+    store->mode_ = Mode::Read;
+    store->filename_ = filename;
+    store->fd_ = ::open(filename.c_str(), O_RDONLY);
+    if (store->fd_ < 0) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version, header_bytes;
+    readAt(store->fd_, magic, sizeof(magic), 0, filename);
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("ResultStore: not a result store file: " + filename);
+    }
+    readAt(store->fd_, &version, sizeof(version), sizeof(MAGIC), filename);
+    readAt(store->fd_, &header_bytes, sizeof(header_bytes), sizeof(MAGIC) + sizeof(version), filename);
+    if (version != VERSION) {
+        throw std::runtime_error("ResultStore: unsupported format version in " + filename);
+    }
+
+    std::vector<char> header(header_bytes);
+    readAt(store->fd_, header.data(), header.size(), 0, filename);
+    std::size_t offset = sizeof(MAGIC) + 2 * sizeof(std::uint32_t);
+    auto read = [&](auto& value) {
+        if (offset + sizeof(value) > header.size()) {
+            throw std::runtime_error("ResultStore: truncated header in " + filename);
+        }
+        std::memcpy(&value, header.data() + offset, sizeof(value));
+        offset += sizeof(value);
+    };
+    std::uint64_t result_dim, num_points, chunk_points, num_axes;
+    read(result_dim);
+    read(num_points);
+    read(chunk_points);
+    read(num_axes);
+    for (std::uint64_t a = 0; a < num_axes; ++a) {
+        std::uint32_t length;
+        read(length);
+        if (offset + length > header.size()) {
+            throw std::runtime_error("ResultStore: truncated header in " + filename);
+        }
+        store->axis_names_.emplace_back(header.data() + offset, length);
+        offset += length;
+    }
+    store->result_dim_ = static_cast<Index>(result_dim);
+    store->num_points_ = static_cast<Index>(num_points);
+    store->chunk_points_ = static_cast<Index>(chunk_points);
+
+    store->flags_offset_ = header_bytes;
+    const std::uint64_t coords_offset = store->flags_offset_ + alignUp(static_cast<std::uint64_t>(store->numChunks()));
+    store->coordinates_.resize(static_cast<Index>(num_axes), store->num_points_);
+    readAt(store->fd_, store->coordinates_.data(), sizeof(double) * store->coordinates_.size(), coords_offset, filename);
+    store->data_offset_ = coords_offset + alignUp(sizeof(double) * store->coordinates_.size());
+    return store;
+}
+
+void ResultStore::begin(Index result_dim, const Mat& coordinates, const std::vector<std::string>& axis_names) {
+    if (mode_ == Mode::Read) {
+        throw std::logic_error("ResultStore::begin: store is read-only.");
+    }
+    result_dim_ = result_dim;
+    num_points_ = coordinates.cols();
+    coordinates_ = coordinates;
+    axis_names_ = axis_names;
+    chunk_fill_.assign(static_cast<std::size_t>(numChunks()), 0);
+
+    if (mode_ == Mode::Memory) {
+        results_.resize(result_dim_, num_points_);
+        return;
+    }
+
+    chunk_buffers_.clear();
+    chunk_buffers_.resize(static_cast<std::size_t>(numChunks()));
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open file: " + filename_);
+    }
+
+    std::vector<char> header;
+    header.insert(header.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    append(header, VERSION);
+    append(header, std::uint32_t(0));  // Header size, patched below
+    append(header, static_cast<std::uint64_t>(result_dim_));
+    append(header, static_cast<std::uint64_t>(num_points_));
+    append(header, static_cast<std::uint64_t>(chunk_points_));
+    append(header, static_cast<std::uint64_t>(axis_names_.size()));
+    for (const std::string& name : axis_names_) {
+        append(header, static_cast<std::uint32_t>(name.size()));
+        header.insert(header.end(), name.begin(), name.end());
+    }
+    header.resize(alignUp(header.size()), '\0');
+    std::uint32_t header_bytes = static_cast<std::uint32_t>(header.size());
+    std::memcpy(header.data() + sizeof(MAGIC) + sizeof(VERSION), &header_bytes, sizeof(header_bytes));
+
+    flags_offset_ = header_bytes;
+    const std::uint64_t flags_bytes = alignUp(static_cast<std::uint64_t>(numChunks()));
+    const std::uint64_t coords_offset = flags_offset_ + flags_bytes;
+    data_offset_ = coords_offset + alignUp(sizeof(double) * coordinates_.size());
+    const std::uint64_t total = data_offset_ + sizeof(double) * static_cast<std::uint64_t>(result_dim_ * num_points_);
+
+    // Header, cleared flags and coordinates; the data section stays sparse until written
+    writeAt(fd_, header.data(), header.size(), 0, filename_);
+    std::vector<char> flags(flags_bytes, 0);
+    writeAt(fd_, flags.data(), flags.size(), flags_offset_, filename_);
+    writeAt(fd_, coordinates_.data(), sizeof(double) * coordinates_.size(), coords_offset, filename_);
+    if (::ftruncate(fd_, static_cast<off_t>(total)) != 0) {
+        throw std::runtime_error("Failed to resize file: " + filename_);
+    }
+}
+
+void ResultStore::store(Index point, const Vec& result) {
+    if (result.size() != result_dim_) {
+        throw std::runtime_error("ResultStore::store: result size differs from the declared result dimension.");
+    }
+    const Index chunk = point / chunk_points_;
+    const Index column = point - chunk * chunk_points_;
+    const Index points_in_chunk = std::min(chunk_points_, num_points_ - chunk * chunk_points_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (mode_ == Mode::Memory) {
+        results_.col(point) = result;
+        ++chunk_fill_[static_cast<std::size_t>(chunk)];
+        return;
+    }
+
+    Mat& buffer = chunk_buffers_[static_cast<std::size_t>(chunk)];
+    if (buffer.size() == 0) {
+        // NaN marks columns never stored if the chunk is written incomplete by end()
+        buffer.setConstant(result_dim_, points_in_chunk, std::numeric_limits<double>::quiet_NaN());
+    }
+    buffer.col(column) = result;
+    if (++chunk_fill_[static_cast<std::size_t>(chunk)] == points_in_chunk) {
+        lock.unlock();  // The chunk is complete and no longer touched by other threads
+        writeChunk(chunk, true);
+    }
+}
+
+void ResultStore::end() {
+    if (mode_ != Mode::Spill) return;
+    for (Index chunk = 0; chunk < numChunks(); ++chunk) {
+        if (chunk_buffers_[static_cast<std::size_t>(chunk)].size() > 0) writeChunk(chunk, false);
+    }
+}
+
+void ResultStore::writeChunk(Index chunk, bool complete) {
+    Mat buffer;
+    buffer.swap(chunk_buffers_[static_cast<std::size_t>(chunk)]);  // Releases the chunk memory
+    const std::uint64_t offset = data_offset_
+        + sizeof(double) * static_cast<std::uint64_t>(chunk * chunk_points_ * result_dim_);
+    writeAt(fd_, buffer.data(), sizeof(double) * buffer.size(), offset, filename_);
+    if (!complete) return;  // The flag stays 0: readers must not take the NaN columns for results
+    const std::uint8_t flag = 1;
+    writeAt(fd_, &flag, 1, flags_offset_ + static_cast<std::uint64_t>(chunk), filename_);
+}
+
+std::uint8_t ResultStore::readFlag(Index chunk) const {
+    std::uint8_t flag = 0;
+    readAt(fd_, &flag, 1, flags_offset_ + static_cast<std::uint64_t>(chunk), filename_);
+    return flag;
+}
+
+Index ResultStore::resultDim() const {
+    return result_dim_;
+}
+
+Index ResultStore::numPoints() const {
+    return num_points_;
+}
+
+Index ResultStore::chunkPoints() const {
+    return chunk_points_;
+}
+
+Index ResultStore::numChunks() const {
+    return (num_points_ + chunk_points_ - 1) / chunk_points_;
+}
+
+const std::vector<std::string>& ResultStore::axisNames() const {
+    return axis_names_;
+}
+
+const Mat& ResultStore::coordinates() const {
+    return coordinates_;
+}
+
+bool ResultStore::isChunkComplete(Index chunk) const {
+    if (chunk < 0 || chunk >= numChunks()) {
+        throw std::out_of_range("ResultStore::isChunkComplete: chunk index out of range.");
+    }
+    if (mode_ == Mode::Memory) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return chunk_fill_[static_cast<std::size_t>(chunk)] == std::min(chunk_points_, num_points_ - chunk * chunk_points_);
+    }
+    return readFlag(chunk) != 0;
+}
+
+Mat ResultStore::readChunk(Index chunk) const {
+    if (!isChunkComplete(chunk)) {
+        throw std::runtime_error("ResultStore::readChunk: chunk " + std::to_string(chunk) + " is not complete.");
+    }
+    const Index first = chunk * chunk_points_;
+    const Index count = std::min(chunk_points_, num_points_ - first);
+    if (mode_ == Mode::Memory) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return results_.middleCols(first, count);
+    }
+    Mat chunk_results(result_dim_, count);
+    readAt(fd_, chunk_results.data(), sizeof(double) * chunk_results.size(),
+           data_offset_ + sizeof(double) * static_cast<std::uint64_t>(first * result_dim_), filename_);
+    return chunk_results;
+}
+
+Mat ResultStore::readPoints(Index first, Index count) const {
+    if (first < 0 || count < 0 || first + count > num_points_) {
+        throw std::out_of_range("ResultStore::readPoints: point range out of range.");
+    }
+    Mat out(result_dim_, count);
+    Index done = 0;
+    while (done < count) {
+        const Index point = first + done;
+        const Index chunk = point / chunk_points_;
+        const Mat chunk_results = readChunk(chunk);
+        const Index offset = point - chunk * chunk_points_;
+        const Index n = std::min(count - done, chunk_results.cols() - offset);
+        out.middleCols(done, n) = chunk_results.middleCols(offset, n);
+        done += n;
+    }
+    return out;
+}
+
+Mat ResultStore::readAll() const {
+    return readPoints(0, num_points_);
+}
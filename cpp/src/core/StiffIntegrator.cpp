@@ -0,0 +1,217 @@
+#include "StiffIntegrator.hpp"
+#include "Definitions.hpp"
+#include "TrajectoryIO.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // ROS2 parameter (L-stable choice)
+    constexpr double GAMMA = 1.0 + 1.0 / Constants::SQRT2;
+
+    // Step size controller (embedded error estimate is first order)
+    constexpr double SAFETY = 0.9;
+    constexpr double MIN_FACTOR = 0.2;
+    constexpr double MAX_FACTOR = 5.0;
+    constexpr double KEEP_FACTOR = 1.2;  // Step size increases below this keep the current LU
+}
+
+StiffIntegrator::StiffIntegrator(AbstractDynamicalSystem& system, double initial_dt)
+    : system_(system), initial_dt_(initial_dt) {}
+
+void StiffIntegrator::setTransientTime(double t_transient) {
+    t_transient_ = t_transient;
+}
+
+void StiffIntegrator::setOutputInterval(double interval) {
+    output_interval_ = interval;
+}
+
+void StiffIntegrator::setTolerances(double rel_tol, double abs_tol) {
+    if (rel_tol <= 0.0 || abs_tol < 0.0) {
+        throw std::invalid_argument("StiffIntegrator::setTolerances: tolerances must be positive.");
+    }
+    rel_tol_ = rel_tol;
+    abs_tol_ = abs_tol;
+}
+
+void StiffIntegrator::setMaxStep(double max_dt) {
+    max_dt_ = max_dt;
+}
+
+const Mat& StiffIntegrator::getResults() const {
+    return results_;
+}
+
+const Vec& StiffIntegrator::getTimes() const {
+    return times_;
+}
+
+const IntegratorStats& StiffIntegrator::getStats() const {
+    return stats_;
+}
+
+void StiffIntegrator::updateJacobian(double t, const Vec& y) {
+    system_.sparseJacobian(t, y, J_);
+    ++stats_.jacobian_evaluations;
+    if (J_.rows() != system_.dim || J_.cols() != system_.dim) {
+        throw std::invalid_argument("StiffIntegrator::integrate: sparseJacobian() must return a dim × dim matrix.");
+    }
+    J_.makeCompressed();
+}
+
+void StiffIntegrator::factorize(double h) {
+    W_ = identity_ - (GAMMA * h) * J_;
+    W_.makeCompressed();
+
+    // The ordering only depends on the sparsity pattern; redo it only if the pattern changed
+    const Index nnz = W_.nonZeros();
+    bool same_pattern = analyzed_
+        && static_cast<Index>(pattern_outer_.size()) == W_.outerSize() + 1
+        && static_cast<Index>(pattern_inner_.size()) == nnz
+        && std::equal(pattern_outer_.begin(), pattern_outer_.end(), W_.outerIndexPtr())
+        && std::equal(pattern_inner_.begin(), pattern_inner_.end(), W_.innerIndexPtr());
+    if (!same_pattern) {
+        lu_.analyzePattern(W_);
+        pattern_outer_.assign(W_.outerIndexPtr(), W_.outerIndexPtr() + W_.outerSize() + 1);
+        pattern_inner_.assign(W_.innerIndexPtr(), W_.innerIndexPtr() + nnz);
+        analyzed_ = true;
+    }
+
+    lu_.factorize(W_);
+    ++stats_.factorizations;
+    if (lu_.info() != Eigen::Success) {
+        throw std::runtime_error("StiffIntegrator::integrate: LU factorisation of I - gamma * h * J failed.");
+    }
+}
+
+void StiffIntegrator::integrate(Vec& y, double t0, double tf) {
+    if (system_.dim == 0) {
+        throw std::invalid_argument("StiffIntegrator::integrate: system dimension (dim) must be set and positive.");
+    }
+    if (y.size() != system_.dim) {
+        throw std::invalid_argument("StiffIntegrator::integrate: input vector y size does not match system dimension.");
+    }
+    if (initial_dt_ <= 0.0) {
+        throw std::invalid_argument("StiffIntegrator::integrate: initial step size must be positive.");
+    }
+    int dim = system_.dim;
+    for (Vec* buffer : {&f0_, &f1_, &k1_, &k2_, &y_new_, &y_temp_}) {
+        if (buffer->size() != dim) buffer->resize(dim);
+    }
+    if (identity_.rows() != dim) {
+        identity_.resize(dim, dim);
+        identity_.setIdentity();
+    }
+    stats_ = IntegratorStats();
+    const auto start_time = std::chrono::steady_clock::now();
+    auto recording_start = start_time;
+
+    const double t_rec = std::max(t0, t_transient_);
+    Index num_samples = (output_interval_ > 0.0 && tf > t_rec)
+        ? static_cast<Index>(std::floor((tf - t_rec) / output_interval_ + 1e-9))
+        : 0;
+    results_.resize(dim, num_samples);
+    times_.resize(num_samples);
+    Index sample_idx = 0;
+
+    double t = t0;
+    double h = initial_dt_;
+    double h_factored = 0.0;      // Step size of the current factorisation; 0 means none
+    bool last_rejected = false;
+    const double t_eps = 1e-12 * std::max(1.0, std::abs(tf));
+
+    system_.rhs(t, y, f0_);
+    ++stats_.rhs_evaluations;
+    updateJacobian(t, y);
+    bool jacobian_current = true;  // Whether J_ was evaluated at the current (t, y)
+
+    while (t < tf - t_eps) {
+        if (max_dt_ > 0.0) h = std::min(h, max_dt_);
+        if (t + h > tf - t_eps) h = tf - t;
+        if (h != h_factored) {
+            factorize(h);
+            h_factored = h;
+        }
+
+        // ROS2 stages: W k1 = f(t, y), W k2 = f(t + h, y + h k1) - 2 k1
+        k1_ = lu_.solve(f0_);
+        y_temp_.noalias() = y + h * k1_;
+        system_.rhs(t + h, y_temp_, f1_);
+        ++stats_.rhs_evaluations;
+        f1_ -= 2.0 * k1_;
+        k2_ = lu_.solve(f1_);
+        y_new_.noalias() = y + (1.5 * h) * k1_ + (0.5 * h) * k2_;
+
+        // Difference to the embedded first-order solution y + h k1
+        y_temp_.noalias() = (0.5 * h) * (k1_ + k2_);
+        double err = std::sqrt((y_temp_.array()
+            / (abs_tol_ + rel_tol_ * y.array().abs().max(y_new_.array().abs()))).square().mean());
+        if (!std::isfinite(err)) err = Constants::LARGE_NUMBER;
+
+        if (err <= 1.0) {
+            ++stats_.steps_taken;
+            system_.rhs(t + h, y_new_, f1_);
+            ++stats_.rhs_evaluations;
+
+            // Fill every output time inside (t, t + h] by cubic Hermite interpolation
+            double t_sample = t_rec + (sample_idx + 1) * output_interval_;
+            while (sample_idx < num_samples && t_sample <= t + h + t_eps) {
+                const double theta = std::min(1.0, (t_sample - t) / h);
+                const double theta2 = theta * theta, theta3 = theta2 * theta;
+                results_.col(sample_idx) = (2.0 * theta3 - 3.0 * theta2 + 1.0) * y
+                                         + (h * (theta3 - 2.0 * theta2 + theta)) * f0_
+                                         + (3.0 * theta2 - 2.0 * theta3) * y_new_
+                                         + (h * (theta3 - theta2)) * f1_;
+                times_(sample_idx) = t_sample;
+                sample_idx++;
+                t_sample = t_rec + (sample_idx + 1) * output_interval_;
+            }
+
+            if (t < t_rec && t + h >= t_rec) {
+                recording_start = std::chrono::steady_clock::now();
+            }
+            t += h;
+            y.swap(y_new_);
+            f0_.swap(f1_);
+            jacobian_current = false;
+
+            double factor = (err == 0.0) ? MAX_FACTOR : SAFETY / std::sqrt(err);
+            factor = std::clamp(factor, MIN_FACTOR, MAX_FACTOR);
+            if (last_rejected) factor = std::min(factor, 1.0);
+            if (factor >= 1.0 && factor <= KEEP_FACTOR) factor = 1.0;  // Keep the factorisation
+            h *= factor;
+            last_rejected = false;
+        } else {
+            ++stats_.steps_rejected;
+            h *= std::max(MIN_FACTOR, SAFETY / std::sqrt(err));
+            last_rejected = true;
+            // Only a rejection can shrink h towards zero; accepted steps may end just short of tf
+            if (h < Constants::SMALL_NUMBER * std::max(1.0, std::abs(t))) {
+                throw std::runtime_error("StiffIntegrator::integrate: step size underflow at t = " + std::to_string(t));
+            }
+
+            // An outdated Jacobian is the likely cause; refresh it at the current point
+            if (!jacobian_current) {
+                updateJacobian(t, y);
+                jacobian_current = true;
+                h_factored = 0.0;
+            }
+        }
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    stats_.transient_seconds = std::chrono::duration<double>(recording_start - start_time).count();
+    stats_.recording_seconds = std::chrono::duration<double>(end_time - recording_start).count();
+
+    // Trim unused columns if rounding left the last grid point unfilled
+    if (sample_idx < num_samples) {
+        results_.conservativeResize(Eigen::NoChange, sample_idx);
+        times_.conservativeResize(sample_idx);
+    }
+}
+
+void StiffIntegrator::writeResultsToCSV(const std::string& filename) const {
+    writeTrajectoryCSV(filename, times_, results_);
+}
@@ -0,0 +1,141 @@
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(int num_threads) : num_threads_(num_threads) {
+    if (num_threads_ <= 0) {
+        num_threads_ = static_cast<int>(std::thread::hardware_concurrency());
+        if (num_threads_ <= 0) num_threads_ = 1;
+    }
+    for (int w = 0; w < num_threads_; ++w) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    // Worker 0 is the thread calling parallelFor(); only helpers get their own thread.
+    for (int w = 1; w < num_threads_; ++w) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+int ThreadPool::size() const {
+    return num_threads_;
+}
+
+void ThreadPool::parallelFor(Index n, const LoopBody& body) {
+    if (n <= 0) return;
+
+    if (num_threads_ == 1) {
+        for (Index i = 0; i < n; ++i) body(i, 0);
+        return;
+    }
+
+    // Static initial partition; stealing rebalances uneven iteration costs.
+    for (int w = 0; w < num_threads_; ++w) {
+        std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+        queues_[w]->begin = n * w / num_threads_;
+        queues_[w]->end = n * (w + 1) / num_threads_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        error_ = nullptr;
+        active_ = num_threads_ - 1;
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    runWorker(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return active_ == 0; });
+        body_ = nullptr;
+        error = error_;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::workerLoop(int worker) {
+    std::uint64_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_) return;
+            seen_generation = generation_;
+        }
+        runWorker(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0) done_cv_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::runWorker(int worker) {
+    Index i;
+    while (nextIndex(worker, i)) {
+        try {
+            (*body_)(i, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+}
+
+bool ThreadPool::nextIndex(int worker, Index& i) {
+    {
+        WorkQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.begin < own.end) {
+            i = own.begin++;
+            return true;
+        }
+    }
+
+    // Own queue is empty: steal the back half of the largest remaining queue.
+    // Sizes are read racily to pick a victim and re-checked under the victim's lock.
+    for (;;) {
+        int victim = -1;
+        Index largest = 0;
+        for (int k = 1; k < num_threads_; ++k) {
+            int w = (worker + k) % num_threads_;
+            std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+            Index remaining = queues_[w]->end - queues_[w]->begin;
+            if (remaining > largest) {
+                largest = remaining;
+                victim = w;
+            }
+        }
+        if (victim < 0) return false;
+
+        Index stolen_begin, stolen_end;
+        {
+            WorkQueue& other = *queues_[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            Index remaining = other.end - other.begin;
+            if (remaining <= 0) continue;  // Drained meanwhile; pick another victim
+            stolen_end = other.end;
+            stolen_begin = other.end - (remaining + 1) / 2;
+            other.end = stolen_begin;
+        }
+
+        WorkQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = stolen_begin + 1;
+        own.end = stolen_end;
+        i = stolen_begin;
+        return true;
+    }
+}
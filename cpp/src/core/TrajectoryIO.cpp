@@ -0,0 +1,282 @@
+#include "TrajectoryIO.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char MAGIC[8] = {'N', 'L', 'D', 'K', 'T', 'R', 'J', '\0'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::size_t ALIGNMENT = 64;
+    constexpr std::size_t WRITE_BUFFER_BYTES = std::size_t(1) << 22;  // 4 MiB per write() call
+
+    // Minimal POSIX file handle that writes fully or throws
+    class OutputFile {
+    public:
+        explicit OutputFile(const std::string& filename) : filename_(filename) {
+            fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd_ < 0) {
+                throw std::runtime_error("Failed to open file: " + filename);
+            }
+        }
+        ~OutputFile() {
+            if (fd_ >= 0) ::close(fd_);
+        }
+
+        void write(const void* data, std::size_t bytes) {
+            const char* p = static_cast<const char*>(data);
+            while (bytes > 0) {
+                ssize_t written = ::write(fd_, p, bytes);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::runtime_error("Failed to write file: " + filename_ + ": " + std::strerror(errno));
+                }
+                p += written;
+                bytes -= static_cast<std::size_t>(written);
+            }
+        }
+
+        void close() {
+            if (::close(fd_) != 0) {
+                fd_ = -1;
+                throw std::runtime_error("Failed to close file: " + filename_);
+            }
+            fd_ = -1;
+        }
+
+    private:
+        std::string filename_;
+        int fd_ = -1;
+    };
+
+    template <typename T>
+    void append(std::vector<char>& buffer, const T& value) {
+        const char* p = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    void appendString(std::vector<char>& buffer, const std::string& value) {
+        append(buffer, static_cast<std::uint32_t>(value.size()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    // Bounds-checked cursor over the mapped header
+    class HeaderReader {
+    public:
+        HeaderReader(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+        template <typename T>
+        T read() {
+            T value;
+            require(sizeof(T));
+            std::memcpy(&value, data_ + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return value;
+        }
+
+        std::string readString() {
+            std::uint32_t length = read<std::uint32_t>();
+            require(length);
+            std::string value(data_ + offset_, length);
+            offset_ += length;
+            return value;
+        }
+
+    private:
+        void require(std::size_t bytes) const {
+            if (offset_ + bytes > size_) {
+                throw std::runtime_error("MappedTrajectory: truncated header.");
+            }
+        }
+
+        const char* data_;
+        std::size_t size_;
+        std::size_t offset_ = 0;
+    };
+}
+
+void writeTrajectoryBinary(const std::string& filename, const Vec& times, const Mat& states,
+                           const TrajectoryMetadata& metadata) {
+    if (states.cols() != times.size()) {
+        throw std::invalid_argument("writeTrajectoryBinary: number of states does not match number of times.");
+    }
+    const Index dim = states.rows();
+    const Index num_samples = states.cols();
+
+    std::vector<char> header;
+    header.insert(header.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    append(header, VERSION);
+    append(header, std::uint32_t(0));  // Header size, patched below
+    append(header, static_cast<std::uint64_t>(dim));
+    append(header, static_cast<std::uint64_t>(num_samples));
+    appendString(header, metadata.abscissa_name);
+    append(header, static_cast<std::uint64_t>(metadata.values.size()));
+    for (const auto& [key, value] : metadata.values) {
+        appendString(header, key);
+        append(header, value);
+    }
+    header.resize((header.size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT, '\0');
+    std::uint32_t header_bytes = static_cast<std::uint32_t>(header.size());
+    std::memcpy(header.data() + sizeof(MAGIC) + sizeof(VERSION), &header_bytes, sizeof(header_bytes));
+
+    OutputFile file(filename);
+    file.write(header.data(), header.size());
+
+    // The abscissa is already contiguous and goes out in one call
+    file.write(times.data(), sizeof(double) * static_cast<std::size_t>(num_samples));
+
+    // State rows are strided in the column-major matrix: gather them into a large buffer
+    const Index buffer_len = static_cast<Index>(WRITE_BUFFER_BYTES / sizeof(double));
+    std::vector<double> buffer(static_cast<std::size_t>(std::min(buffer_len, std::max<Index>(num_samples, 1))));
+    const Index chunk = static_cast<Index>(buffer.size());
+    for (Index row = 0; row < dim; ++row) {
+        for (Index start = 0; start < num_samples; start += chunk) {
+            Index count = std::min(chunk, num_samples - start);
+            Eigen::Map<RowVec>(buffer.data(), count) = states.row(row).segment(start, count);
+            file.write(buffer.data(), sizeof(double) * static_cast<std::size_t>(count));
+        }
+    }
+    file.close();
+}
+
+void writeTrajectoryCSV(const std::string& filename, const Vec& times, const Mat& states) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+
+    // Set scientific format with high precision
+    file << std::scientific << std::setprecision(15);
+
+    // Write header
+    file << "time";
+    for (int i = 0; i < states.rows(); ++i) {
+        file << ",state_" << i;
+    }
+    file << "\n";
+
+    // Write data
+    for (int col = 0; col < states.cols(); ++col) {
+        file << times(col);
+        for (int row = 0; row < states.rows(); ++row) {
+            file << "," << states(row, col);
+        }
+        file << "\n";
+    }
+
+    file.close();
+}
+
+MappedTrajectory::MappedTrajectory(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(MAGIC))) {
+        ::close(fd);
+        throw std::runtime_error("MappedTrajectory: not a trajectory file: " + filename);
+    }
+    mapped_bytes_ = static_cast<std::size_t>(info.st_size);
+    mapping_ = ::mmap(nullptr, mapped_bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::runtime_error("MappedTrajectory: mmap failed for " + filename);
+    }
+
+    try {
+        const char* bytes = static_cast<const char*>(mapping_);
+        if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("MappedTrajectory: not a trajectory file: " + filename);
+        }
+        HeaderReader reader(bytes + sizeof(MAGIC), mapped_bytes_ - sizeof(MAGIC));
+        if (reader.read<std::uint32_t>() != VERSION) {
+            throw std::runtime_error("MappedTrajectory: unsupported format version in " + filename);
+        }
+        std::uint32_t header_bytes = reader.read<std::uint32_t>();
+        dim_ = static_cast<Index>(reader.read<std::uint64_t>());
+        num_samples_ = static_cast<Index>(reader.read<std::uint64_t>());
+        metadata_.abscissa_name = reader.readString();
+        std::uint64_t num_values = reader.read<std::uint64_t>();
+        for (std::uint64_t i = 0; i < num_values; ++i) {
+            std::string key = reader.readString();
+            metadata_.values[key] = reader.read<double>();
+        }
+
+        std::size_t data_bytes = sizeof(double) * static_cast<std::size_t>((dim_ + 1) * num_samples_);
+        if (header_bytes % ALIGNMENT != 0 || header_bytes + data_bytes > mapped_bytes_) {
+            throw std::runtime_error("MappedTrajectory: truncated data in " + filename);
+        }
+        data_ = reinterpret_cast<const double*>(bytes + header_bytes);
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+MappedTrajectory::~MappedTrajectory() {
+    unmap();
+}
+
+MappedTrajectory::MappedTrajectory(MappedTrajectory&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedTrajectory& MappedTrajectory::operator=(MappedTrajectory&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+        dim_ = std::exchange(other.dim_, 0);
+        num_samples_ = std::exchange(other.num_samples_, 0);
+        metadata_ = std::move(other.metadata_);
+    }
+    return *this;
+}
+
+void MappedTrajectory::unmap() {
+    if (mapping_) {
+        ::munmap(mapping_, mapped_bytes_);
+        mapping_ = nullptr;
+    }
+    data_ = nullptr;
+}
+
+Index MappedTrajectory::dim() const {
+    return dim_;
+}
+
+Index MappedTrajectory::numSamples() const {
+    return num_samples_;
+}
+
+const TrajectoryMetadata& MappedTrajectory::metadata() const {
+    return metadata_;
+}
+
+Eigen::Map<const Vec> MappedTrajectory::times() const {
+    return Eigen::Map<const Vec>(data_, num_samples_);
+}
+
+Eigen::Map<const Mat> MappedTrajectory::columns() const {
+    return Eigen::Map<const Mat>(data_ + num_samples_, num_samples_, dim_);
+}
+
+Eigen::Map<const Vec> MappedTrajectory::column(Index i) const {
+    if (i < 0 || i >= dim_) {
+        throw std::out_of_range("MappedTrajectory::column: index out of range.");
+    }
+    return Eigen::Map<const Vec>(data_ + (i + 1) * num_samples_, num_samples_);
+}
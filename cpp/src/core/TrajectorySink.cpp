@@ -0,0 +1,144 @@
+#include "TrajectorySink.hpp"
+#include "Checkpoint.hpp"
+#include <cstdint>
+#include <iomanip>
+#include <stdexcept>
+
+void TrajectorySink::resume(int dim, Index samples, CheckpointData& state) {
+    throw std::runtime_error("TrajectorySink: this sink cannot resume an interrupted integration.");
+}
+
+// ===================================================
+//               CSVFileSink
+// ===================================================
+
+CSVFileSink::CSVFileSink(const std::string& filename) : filename_(filename) {}
+
+void CSVFileSink::setFormat() {
+    if (!file_.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename_);
+    }
+    // Set scientific format with high precision
+    file_ << std::scientific << std::setprecision(15);
+}
+
+void CSVFileSink::begin(int dim) {
+    file_.open(filename_);
+    setFormat();
+
+    // Write header
+    file_ << "time";
+    for (int i = 0; i < dim; ++i) {
+        file_ << ",state_" << i;
+    }
+    file_ << "\n";
+}
+
+void CSVFileSink::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    for (Index col = 0; col < states.cols(); ++col) {
+        file_ << times(col);
+        for (Index row = 0; row < states.rows(); ++row) {
+            file_ << "," << states(row, col);
+        }
+        file_ << "\n";
+    }
+}
+
+void CSVFileSink::end() {
+    file_.close();
+}
+
+void CSVFileSink::saveState(CheckpointData& state) const {
+    file_.flush();
+    const std::streamoff written = file_.tellp();
+    if (!file_ || written < 0) {
+        throw std::runtime_error("Failed to write file: " + filename_);
+    }
+    state.put(static_cast<std::int64_t>(written));
+}
+
+void CSVFileSink::resume(int dim, Index samples, CheckpointData& state) {
+    // Rows written after the checkpoint are cut off; the file then grows from there
+    const std::int64_t written = state.get<std::int64_t>();
+    if (file_.is_open()) file_.close();
+    resizeFile(filename_, static_cast<std::uint64_t>(written));
+    file_.open(filename_, std::ios::app);
+    setFormat();
+}
+
+// ===================================================
+//               RingBufferSink
+// ===================================================
+
+RingBufferSink::RingBufferSink(Index capacity) : capacity_(capacity) {
+    if (capacity_ <= 0) {
+        throw std::invalid_argument("RingBufferSink: capacity must be positive.");
+    }
+}
+
+void RingBufferSink::begin(int dim) {
+    states_.resize(dim, capacity_);
+    times_.resize(capacity_);
+    next_ = 0;
+    count_ = 0;
+}
+
+void RingBufferSink::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    for (Index col = 0; col < states.cols(); ++col) {
+        states_.col(next_) = states.col(col);
+        times_(next_) = times(col);
+        next_ = (next_ + 1) % capacity_;
+        if (count_ < capacity_) ++count_;
+    }
+}
+
+void RingBufferSink::saveState(CheckpointData& state) const {
+    state.put(static_cast<std::int64_t>(next_));
+    state.put(static_cast<std::int64_t>(count_));
+    state.putMat(states_);
+    state.putVec(times_);
+}
+
+void RingBufferSink::resume(int dim, Index samples, CheckpointData& state) {
+    next_ = static_cast<Index>(state.get<std::int64_t>());
+    count_ = static_cast<Index>(state.get<std::int64_t>());
+    states_ = state.getMat();
+    times_ = state.getVec();
+    if (states_.rows() != dim || states_.cols() != capacity_ || times_.size() != capacity_) {
+        throw std::invalid_argument("RingBufferSink::resume: capacity or dimension differs from the checkpointed run.");
+    }
+}
+
+Index RingBufferSink::size() const {
+    return count_;
+}
+
+Mat RingBufferSink::getResults() const {
+    Mat ordered(states_.rows(), count_);
+    Index oldest = (next_ - count_ + capacity_) % capacity_;
+    for (Index i = 0; i < count_; ++i) {
+        ordered.col(i) = states_.col((oldest + i) % capacity_);
+    }
+    return ordered;
+}
+
+Vec RingBufferSink::getTimes() const {
+    Vec ordered(count_);
+    Index oldest = (next_ - count_ + capacity_) % capacity_;
+    for (Index i = 0; i < count_; ++i) {
+        ordered(i) = times_((oldest + i) % capacity_);
+    }
+    return ordered;
+}
+
+// ===================================================
+//               CallbackSink
+// ===================================================
+
+CallbackSink::CallbackSink(ChunkFunc func) : func_(std::move(func)) {}
+
+void CallbackSink::consume(const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+    func_(states, times);
+}
+
+void CallbackSink::resume(int dim, Index samples, CheckpointData& state) {}
@@ -0,0 +1,204 @@
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AbstractDynamicalSystem.hpp"
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "ParameterSweep.hpp"
+#include "systems/DampedOscillator.hpp"
+#include "systems/Lorenz.hpp"
+#include "systems/Pendulum.hpp"
+
+// Python module `nldkit`: systems, Integrator and ParameterSweep.
+//
+// Results are returned as read-only NumPy views of the C++ buffers (no copy); a view keeps
+// its integrator or sweep alive. The next integrate() / run_sweep() / set_parameter_range()
+// would overwrite or reallocate those buffers, so it raises RuntimeError while any view of
+// the previous results is still referenced: keep a copy (numpy.array(view)) instead.
+// Integration and sweeps run with the GIL released. Python post-processing is batched:
+// the callable receives the trajectories of many points at once.
+
+namespace py = pybind11;
+
+namespace {
+    // Read-only view of `data` with the given shape and strides (in elements), kept alive by owner
+    py::array view(const double* data, std::vector<py::ssize_t> shape, std::vector<py::ssize_t> strides,
+                   py::handle owner) {
+        for (py::ssize_t& stride : strides) stride *= static_cast<py::ssize_t>(sizeof(double));
+        py::array array(py::dtype::of<double>(), std::move(shape), std::move(strides), data, owner);
+        array.attr("setflags")(py::arg("write") = false);
+        return array;
+    }
+
+    // Number of result views alive per integrator or sweep object (guarded by the GIL)
+    std::unordered_map<PyObject*, Index>& liveViews() {
+        static std::unordered_map<PyObject*, Index> views;
+        return views;
+    }
+
+    // Base of a result view: keeps owner alive and counts as one of its live views until the
+    // view (and every array derived from it) is gone
+    py::capsule viewBase(py::handle owner) {
+        owner.inc_ref();
+        ++liveViews()[owner.ptr()];
+        return py::capsule(owner.ptr(), [](void* ptr) {
+            PyObject* object = static_cast<PyObject*>(ptr);
+            auto it = liveViews().find(object);
+            if (--it->second == 0) liveViews().erase(it);
+            Py_DECREF(object);
+        });
+    }
+
+    // Called before anything that rewrites the buffers behind the views of owner
+    void requireNoViews(py::handle owner, const char* caller) {
+        if (liveViews().count(owner.ptr()) != 0) {
+            throw std::runtime_error(std::string(caller) + ": results of the previous run are still referenced; "
+                                     "copy them (numpy.array(...)) or delete them first.");
+        }
+    }
+
+    // dim × cols column-major matrix as a (rows, cols) array
+    py::array matrixView(const Mat& m, py::handle owner) {
+        return view(m.data(), {m.rows(), m.cols()}, {1, m.rows()}, viewBase(owner));
+    }
+
+    py::array vectorView(const double* data, Index size, py::handle owner) {
+        return view(data, {size}, {1}, viewBase(owner));
+    }
+
+    // Wraps a Python callable batch(trajectories) -> results for ParameterSweep. The callable
+    // gets a read-only (count, dim, num_samples) view of the batch, valid during the call only,
+    // and returns an array of shape (count,) or (count, result_dim).
+    ParameterSweep::BatchPostProcessFunc wrapBatch(py::function func) {
+        return [func](const Mat& trajectories, Index count) -> Mat {
+            py::gil_scoped_acquire acquire;
+            const Index dim = trajectories.rows();
+            const Index num_samples = trajectories.cols() / count;
+            py::capsule borrowed(trajectories.data(), [](void*) {});  // Base without ownership: no copy
+            py::array batch = view(trajectories.data(), {count, dim, num_samples}, {dim * num_samples, 1, dim},
+                                   borrowed);
+
+            using Result = py::array_t<double, py::array::c_style | py::array::forcecast>;
+            Result out = Result::ensure(func(batch));
+            if (!out || out.ndim() < 1 || out.ndim() > 2 || out.shape(0) != count) {
+                throw std::runtime_error("Post-processing must return an array of shape (count,) or (count, result_dim).");
+            }
+            const Index result_dim = (out.ndim() == 2) ? out.shape(1) : 1;
+            Mat results(result_dim, count);
+            const double* data = out.data();
+            for (Index j = 0; j < count; ++j) {
+                for (Index r = 0; r < result_dim; ++r) results(r, j) = data[j * result_dim + r];
+            }
+            return results;
+        };
+    }
+}
+
+PYBIND11_MODULE(nldkit, m) {
+    m.doc() = "NLDKit: integration and parameter sweeps of nonlinear dynamical systems";
+
+    py::class_<AbstractDynamicalSystem>(m, "DynamicalSystem")
+        .def_readonly("dim", &AbstractDynamicalSystem::dim)
+        .def("set_parameter",
+             static_cast<void (AbstractDynamicalSystem::*)(const std::string&, double)>(
+                 &AbstractDynamicalSystem::setParameter),
+             py::arg("name"), py::arg("value"))
+        .def("get_parameter",
+             static_cast<double (AbstractDynamicalSystem::*)(const std::string&) const>(
+                 &AbstractDynamicalSystem::getParameter),
+             py::arg("name"))
+        .def("rhs", [](AbstractDynamicalSystem& self, double t, const Vec& y) {
+            if (y.size() != self.dim) throw std::invalid_argument("rhs: state size does not match the system dimension.");
+            Vec dydt(self.dim);
+            self.rhs(t, y, dydt);
+            return dydt;
+        }, py::arg("t"), py::arg("y"));
+
+    py::class_<DampedOscillator, AbstractDynamicalSystem>(m, "DampedOscillator")
+        .def(py::init<double, double>(), py::arg("omega"), py::arg("gamma"));
+
+    py::class_<Lorenz, AbstractDynamicalSystem>(m, "Lorenz")
+        .def(py::init<double, double, double>(), py::arg("sigma") = 10.0, py::arg("rho") = 28.0,
+             py::arg("beta") = 8.0 / 3.0);
+
+    py::class_<Pendulum, AbstractDynamicalSystem>(m, "Pendulum")
+        .def(py::init<double>(), py::arg("omega") = 1.0)
+        .def("energy", &Pendulum::energy, py::arg("y"));
+
+    py::class_<Integrator> integrator(m, "Integrator");
+    py::enum_<Integrator::Method>(integrator, "Method")
+        .value("RK4", Integrator::Method::RK4)
+        .value("VelocityVerlet", Integrator::Method::VelocityVerlet)
+        .value("Yoshida4", Integrator::Method::Yoshida4)
+        .value("Yoshida6", Integrator::Method::Yoshida6);
+    integrator
+        .def(py::init<AbstractDynamicalSystem&, double>(), py::arg("system"), py::arg("dt"),
+             py::keep_alive<1, 2>())
+        .def("set_transient_time", &Integrator::setTransientTime, py::arg("t_transient"))
+        .def("set_output_interval", &Integrator::setOutputInterval, py::arg("interval"))
+        .def("set_method", &Integrator::setMethod, py::arg("method"))
+        .def("integrate", [](py::object self, Vec y, double t0, double tf) {
+            requireNoViews(self, "integrate");
+            Integrator& integrator = self.cast<Integrator&>();
+            {
+                py::gil_scoped_release release;
+                integrator.integrate(y, t0, tf);
+            }
+            return y;
+        }, py::arg("y0"), py::arg("t0"), py::arg("tf"), "Integrates from y0 and returns the final state.")
+        .def("get_results", [](py::object self) {
+            return matrixView(self.cast<const Integrator&>().getResults(), self);
+        }, "Recorded states, shape (dim, num_samples), sharing the integrator's buffer (copy it to keep it across runs).")
+        .def("get_times", [](py::object self) {
+            const Vec& times = self.cast<const Integrator&>().getTimes();
+            return vectorView(times.data(), times.size(), self);
+        }, "Sample times, shape (num_samples,), sharing the integrator's buffer (copy it to keep it across runs).")
+        .def("get_final_time", &Integrator::getFinalTime)
+        .def("write_results_to_csv", &Integrator::writeResultsToCSV, py::arg("filename"))
+        .def("write_results_to_binary", [](const Integrator& self, const std::string& filename) {
+            self.writeResultsToBinary(filename);
+        }, py::arg("filename"));
+
+    py::class_<ParameterSweep> sweep(m, "ParameterSweep");
+    py::enum_<ParameterSweep::Backend>(sweep, "Backend")
+        .value("Scalar", ParameterSweep::Backend::Scalar)
+        .value("Ensemble", ParameterSweep::Backend::Ensemble);
+    sweep
+        .def(py::init<AbstractDynamicalSystem&, const std::string&>(), py::arg("system"), py::arg("param_name"),
+             py::keep_alive<1, 2>())
+        .def("set_parameter_range", [](py::object self, double start, double end, int num_steps) {
+            requireNoViews(self, "set_parameter_range");
+            self.cast<ParameterSweep&>().setParameterRange(start, end, num_steps);
+        }, py::arg("start"), py::arg("end"), py::arg("num_steps"))
+        .def("set_time_step", &ParameterSweep::setTimeStep, py::arg("dt"))
+        .def("set_transient_time", &ParameterSweep::setTransientTime, py::arg("transient_time"))
+        .def("set_output_interval", &ParameterSweep::setOutputInterval, py::arg("interval"))
+        .def("set_num_threads", &ParameterSweep::setNumThreads, py::arg("num_threads"))
+        .def("set_post_processing_function", [](ParameterSweep& self, py::function func, Index batch_size) {
+            self.setBatchPostProcessingFunction(wrapBatch(std::move(func)), batch_size);
+        }, py::arg("func"), py::arg("batch_size") = 256,
+           "Sets func(trajectories) -> results, called once per batch of up to batch_size points with a "
+           "read-only (count, dim, num_samples) array; it returns shape (count,) or (count, result_dim).")
+        .def("run_sweep", [](py::object self, const Vec& y0, double t0, double tf) {
+            requireNoViews(self, "run_sweep");
+            ParameterSweep& sweep = self.cast<ParameterSweep&>();
+            py::gil_scoped_release release;  // Reacquired only around the post-processing calls
+            sweep.runSweep(y0, t0, tf);
+        }, py::arg("y0"), py::arg("t0"), py::arg("tf"))
+        .def("get_parameter_values", [](py::object self) {
+            const std::vector<double>& values = self.cast<const ParameterSweep&>().getParameterValues();
+            return vectorView(values.data(), static_cast<Index>(values.size()), self);
+        }, "Swept parameter values, sharing the sweep's buffer (copy it to keep it across runs).")
+        .def("get_processed_results", [](py::object self) {
+            return matrixView(self.cast<const ParameterSweep&>().getProcessedResults(), self);
+        }, "Processed results, shape (result_dim, num_points), sharing the sweep's buffer (copy it to keep it across runs).")
+        .def("write_results_to_csv", &ParameterSweep::writeResultsToCSV, py::arg("filename"))
+        .def("write_results_to_binary", &ParameterSweep::writeResultsToBinary, py::arg("filename"));
+}
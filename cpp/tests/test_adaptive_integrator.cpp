@@ -0,0 +1,74 @@
+#include <cmath>
+#include <iostream>
+#include "Definitions.hpp"
+#include "AdaptiveIntegrator.hpp"
+#include "Integrator.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Analytic position of the underdamped oscillator x'' + 2 gamma x' + omega^2 x = 0
+static double analyticPosition(double t, double omega, double gamma, double x0, double v0) {
+    double omega_d = std::sqrt(omega * omega - gamma * gamma);
+    return std::exp(-gamma * t) * (x0 * std::cos(omega_d * t) + (v0 + gamma * x0) / omega_d * std::sin(omega_d * t));
+}
+
+int main() {
+    const double omega = 1.0, gamma = 0.1;
+    const double x0 = 0.2, v0 = -2.0;
+    DampedOscillator oscillator(omega, gamma);
+
+    Vec y(2);
+    y << x0, v0;
+
+    AdaptiveIntegrator integrator(oscillator, 0.01);
+    integrator.setTolerances(1e-9, 1e-12);
+    integrator.setTransientTime(5.0);
+    integrator.setOutputInterval(0.1);
+    integrator.integrate(y, 0.0, 50.0);
+
+    const Mat& results = integrator.getResults();
+    const Vec& times = integrator.getTimes();
+    if (results.cols() != 450 || times.size() != 450) {
+        std::cerr << "Unexpected number of samples: " << results.cols() << std::endl;
+        return 1;
+    }
+
+    double max_error = 0.0;
+    for (Index i = 0; i < times.size(); ++i) {
+        if (std::abs(times(i) - (5.0 + 0.1 * (i + 1))) > 1e-12) {
+            std::cerr << "Sample " << i << " is off the output grid: t = " << times(i) << std::endl;
+            return 1;
+        }
+        max_error = std::max(max_error, std::abs(results(0, i) - analyticPosition(times(i), omega, gamma, x0, v0)));
+    }
+    if (max_error > 1e-7) {
+        std::cerr << "Dense output error too large: " << max_error << std::endl;
+        return 1;
+    }
+
+    // FSAL: one initial evaluation plus six per attempted step
+    long long steps = integrator.getAcceptedSteps() + integrator.getRejectedSteps();
+    if (integrator.getRhsEvaluations() != 1 + 6 * steps) {
+        std::cerr << "Unexpected RHS evaluation count" << std::endl;
+        return 1;
+    }
+
+    // Fixed-step RK4 on the same grid, for comparison of the cost
+    Vec y_rk4(2);
+    y_rk4 << x0, v0;
+    Integrator rk4(oscillator, 0.01);
+    rk4.setTransientTime(5.0);
+    rk4.setOutputInterval(0.1);
+    rk4.integrate(y_rk4, 0.0, 50.0);
+
+    // A step ending just short of tf leaves a tiny final step; the larger step proposed after
+    // it must not be taken for an underflow
+    Vec rest = Vec::Zero(2);
+    AdaptiveIntegrator short_tail(oscillator, 1.0);
+    short_tail.integrate(rest, 0.0, 1.0 + 5e-12);
+
+    std::cout << "DOPRI5: max error " << max_error << ", " << integrator.getRhsEvaluations()
+              << " RHS evaluations (" << integrator.getAcceptedSteps() << " accepted, "
+              << integrator.getRejectedSteps() << " rejected)" << std::endl;
+    std::cout << "RK4 (dt = 0.01): " << rk4.getRhsEvaluations() << " RHS evaluations" << std::endl;
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "Definitions.hpp"
+#include "Event.hpp"
+#include "Integrator.hpp"
+#include "NetworkSystem.hpp"
+#include "SweepWorkspace.hpp"
+#include "systems/DampedOscillator.hpp"
+#include "systems/Lorenz.hpp"
+
+// Counts heap allocations by interposing malloc (Eigen and operator new both end up there).
+// The glibc entry points make this possible without a custom allocator; elsewhere the
+// test only checks that everything runs.
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+}
+
+namespace {
+    std::atomic<bool> counting{false};
+    std::atomic<long> allocations{0};
+
+    void count() {
+        if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+extern "C" {
+void* malloc(std::size_t size) {
+    count();
+    return __libc_malloc(size);
+}
+void* calloc(std::size_t n, std::size_t size) {
+    count();
+    return __libc_calloc(n, size);
+}
+void* realloc(void* ptr, std::size_t size) {
+    count();
+    return __libc_realloc(ptr, size);
+}
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+    count();
+    return __libc_memalign(alignment, size);
+}
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) {
+    count();
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : ENOMEM;
+}
+}
+constexpr bool TRACKING = true;
+#else
+namespace {
+    std::atomic<bool> counting{false};
+    std::atomic<long> allocations{0};
+}
+constexpr bool TRACKING = false;
+#endif
+
+// Diffusive ring of n nodes
+static SparseMat ringLaplacian(int n) {
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int i = 0; i < n; ++i) {
+        entries.emplace_back(i, (i + n - 1) % n, 1.0);
+        entries.emplace_back(i, i, -2.0);
+        entries.emplace_back(i, (i + 1) % n, 1.0);
+    }
+    SparseMat laplacian(n, n);
+    laplacian.setFromTriplets(entries.begin(), entries.end());
+    return laplacian;
+}
+
+// Heap allocations made by f
+template <typename F>
+long allocationsIn(F&& f) {
+    allocations = 0;
+    counting = true;
+    f();
+    counting = false;
+    return allocations;
+}
+
+// A warmed-up integrator (and a reused sweep workspace) must not touch the heap in integrate()
+int main() {
+    if (TRACKING && allocationsIn([] { Vec v(100); v.setZero(); }) == 0) {
+        std::cerr << "Allocation hook is not active" << std::endl;
+        return 1;
+    }
+
+    DampedOscillator oscillator(1.0, 0.0);
+    Vec y(2);
+    Integrator recording(oscillator, 0.01);
+    recording.setTransientTime(5.0);
+    recording.setOutputInterval(0.1);
+    y << 1.0, 0.0;
+    recording.integrate(y, 0.0, 50.0);  // Sizes the stage buffers and the result matrix
+    y << 1.0, 0.0;
+    long count = allocationsIn([&] { recording.integrate(y, 0.0, 50.0); });
+    if (count != 0) {
+        std::cerr << "Recording integrate() allocated " << count << " times" << std::endl;
+        return 1;
+    }
+
+    Lorenz lorenz;
+    Vec x(3);
+    Integrator final_state(lorenz, 0.005);
+    x << 1.0, 1.0, 1.0;
+    final_state.integrate(x, 0.0, 1.0);
+    count = allocationsIn([&] { final_state.integrate(x, 0.0, 20.0); });
+    if (count != 0) {
+        std::cerr << "Lorenz integrate() without output allocated " << count << " times" << std::endl;
+        return 1;
+    }
+
+    // Crossing storage keeps its capacity between runs with the same crossings
+    Integrator with_events(oscillator, 0.01);
+    Event zero;
+    zero.g = [](double, const Vec& state) { return state[0]; };
+    with_events.addEvent(zero);
+    y << 1.0, 0.0;
+    with_events.integrate(y, 0.0, 30.0);
+    y << 1.0, 0.0;
+    count = allocationsIn([&] { with_events.integrate(y, 0.0, 30.0); });
+    if (count != 0 || with_events.getEventIds().size() != 10) {
+        std::cerr << "integrate() with events allocated " << count << " times" << std::endl;
+        return 1;
+    }
+
+    // Sweep points after the first reuse the workspace buffers
+    Vec y0(2);
+    y0 << 1.0, 0.0;
+    SweepWorkspace workspace(oscillator, 0.01, 10.0, 0.05);
+    workspace.integrate(y0, 0.0, 40.0);
+    count = allocationsIn([&] {
+        for (int k = 0; k < 20; ++k) {
+            oscillator.setParameter(DampedOscillator::OMEGA, 0.5 + 0.1 * k);
+            workspace.integrate(y0, 0.0, 40.0);
+        }
+    });
+    if (count != 0) {
+        std::cerr << "Reused sweep workspace allocated " << count << " times" << std::endl;
+        return 1;
+    }
+
+    // Threaded network right-hand side: several blocks per call, each on the pool
+    NetworkSystem<DampedOscillator, 2> network(DampedOscillator(1.0, 0.1), ringLaplacian(3 * 2048), 0.4, 0, 1);
+    network.setNumThreads(4);
+    Vec z = Vec::Ones(network.dim);
+    Integrator network_integrator(network, 0.01);
+    network_integrator.integrate(z, 0.0, 0.1);
+    count = allocationsIn([&] { network_integrator.integrate(z, 0.0, 1.0); });
+    if (count != 0) {
+        std::cerr << "Threaded network integrate() allocated " << count << " times" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Allocation test passed" << (TRACKING ? "" : " (allocation tracking unavailable)") << std::endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+"""Smoke test of the nldkit Python module: zero-copy results, the guard against overwriting
+results that are still referenced, and batched post-processing of a sweep."""
+import sys
+
+import numpy as np
+
+import nldkit
+
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+
+def main():
+    oscillator = nldkit.DampedOscillator(omega=1.0, gamma=0.1)
+    integrator = nldkit.Integrator(oscillator, 0.01)
+    integrator.set_output_interval(0.1)
+    y = integrator.integrate(np.array([1.0, 0.0]), 0.0, 10.0)
+
+    results = integrator.get_results()
+    times = integrator.get_times()
+    if results.shape != (2, 101) or times.shape != (101,) or results.flags.writeable:
+        fail("Unexpected result views: %s, %s" % (results.shape, times.shape))
+    if not np.array_equal(results[:, -1], y) or abs(times[-1] - 10.0) > 1e-9:
+        fail("Result views do not hold the integration")
+
+    # A new run would overwrite the buffers behind the views: refused until only copies remain
+    kept = np.array(results)
+    first_row = results[0]
+    del results, times
+    try:
+        integrator.integrate(np.array([2.0, 0.0]), 0.0, 10.0)
+        fail("integrate() ran while a view of the previous results was alive")
+    except RuntimeError:
+        pass
+    del first_row
+    integrator.integrate(np.array([2.0, 0.0]), 0.0, 10.0)
+    if not np.allclose(integrator.get_results(), 2.0 * kept):
+        fail("Second integration is not twice the first")
+
+    # Batched post-processing sees every point exactly once
+    sweep = nldkit.ParameterSweep(oscillator, "gamma")
+    sweep.set_parameter_range(0.0, 0.5, 11)
+    sweep.set_time_step(0.01)
+    sweep.set_transient_time(5.0)
+    sweep.set_output_interval(0.1)
+    sweep.set_num_threads(2)
+    sweep.set_post_processing_function(lambda batch: np.abs(batch[:, 0, :]).max(axis=1), batch_size=4)
+    sweep.run_sweep(np.array([1.0, 0.0]), 0.0, 20.0)
+    amplitudes = sweep.get_processed_results()
+    if amplitudes.shape != (1, 11) or sweep.get_parameter_values().shape != (11,):
+        fail("Unexpected sweep result shape: %s" % (amplitudes.shape,))
+    if abs(amplitudes[0, 0] - 1.0) > 1e-2 or not np.all(np.diff(amplitudes[0]) <= 0.0):
+        fail("Sweep amplitudes do not decrease with the damping: %s" % amplitudes[0])
+    try:
+        sweep.run_sweep(np.array([1.0, 0.0]), 0.0, 20.0)
+        fail("run_sweep() ran while a view of the previous results was alive")
+    except RuntimeError:
+        pass
+
+    print("Python bindings test passed")
+
+
+if __name__ == "__main__":
+    main()
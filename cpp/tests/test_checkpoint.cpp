@@ -0,0 +1,249 @@
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "ParameterSweep.hpp"
+#include "Reducer.hpp"
+#include "TrajectorySink.hpp"
+#include "systems/DampedOscillator.hpp"
+#include "systems/Lorenz.hpp"
+
+// Lorenz system that fails after a number of right-hand side calls, simulating a preempted job
+class FailingLorenz : public Lorenz {
+public:
+    explicit FailingLorenz(long long fail_after) : fail_after_(fail_after) {}
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        if (++calls_ > fail_after_) throw std::runtime_error("preempted");
+        Lorenz::rhs(t, y, dydt);
+    }
+
+private:
+    long long fail_after_;
+    long long calls_ = 0;
+};
+
+static std::string readFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void configure(Integrator& integrator) {
+    integrator.setTransientTime(5.0);
+    integrator.setOutputInterval(0.05);
+    integrator.addEvent({[](double t, const Vec& state) { return state[0]; }, Event::Direction::Rising});
+}
+
+int main() {
+    const std::string checkpoint = (std::filesystem::temp_directory_path() / "nldkit_test_checkpoint.ckpt").string();
+    Vec y0(3);
+    y0 << 1.0, 1.0, 1.0;
+
+    // Uninterrupted reference run
+    Lorenz lorenz;
+    Integrator reference(lorenz, 0.01);
+    configure(reference);
+    Vec y_ref = y0;
+    reference.integrate(y_ref, 0.0, 30.0);
+
+    // Interrupted in the transient and in the recording phase, then resumed
+    for (long long fail_after : {1201LL, 7002LL}) {
+        {
+            FailingLorenz failing(fail_after);
+            Integrator interrupted(failing, 0.01);
+            configure(interrupted);
+            interrupted.setCheckpoint(checkpoint, 250);
+            Vec y = y0;
+            try {
+                interrupted.integrate(y, 0.0, 30.0);
+                std::cerr << "Integration was not interrupted" << std::endl;
+                return 1;
+            } catch (const std::runtime_error&) {
+            }
+        }  // Destroying the integrator finishes the pending checkpoint write
+
+        Lorenz fresh;
+        Integrator resumed(fresh, 0.01);
+        configure(resumed);
+        Vec y;
+        resumed.resume(y, checkpoint);
+        if (y != y_ref || resumed.getResults() != reference.getResults()
+            || resumed.getTimes() != reference.getTimes()
+            || resumed.getEventTimes() != reference.getEventTimes()
+            || resumed.getEventIds() != reference.getEventIds()
+            || resumed.getStats().steps_taken != reference.getStats().steps_taken) {
+            std::cerr << "Resumed integration differs from the reference (failure after "
+                      << fail_after << " rhs calls)" << std::endl;
+            return 1;
+        }
+    }
+
+    // Streamed runs: the sinks continue from their checkpointed state, so the CSV file and
+    // the reducer statistics match an uninterrupted run
+    const auto temp = std::filesystem::temp_directory_path();
+    const std::string csv_ref = (temp / "nldkit_test_checkpoint_ref.csv").string();
+    const std::string csv_out = (temp / "nldkit_test_checkpoint_out.csv").string();
+    auto make_reducers = [] {
+        ReducerSet set;
+        set.add(MinMaxReducer()).add(MeanVarianceReducer()).add(PeakReducer(0)).add(PeriodReducer(0))
+           .add(HistogramReducer(2, 0.0, 50.0, 10)).add(SpectralReducer(0, {0.5, 1.3}));
+        return set;
+    };
+    Vec expected_stats;
+    {
+        CSVFileSink csv(csv_ref);
+        Integrator streamed(lorenz, 0.01);
+        configure(streamed);
+        streamed.setSink(&csv, 64);
+        Vec y = y0;
+        streamed.integrate(y, 0.0, 30.0);
+
+        ReducerSet reducers = make_reducers();
+        streamed.setSink(&reducers, 64);
+        y = y0;
+        streamed.integrate(y, 0.0, 30.0);
+        expected_stats = reducers.result();
+    }
+    for (long long fail_after : {1201LL, 7002LL}) {
+        for (bool use_csv : {true, false}) {
+            CSVFileSink csv(csv_out);
+            ReducerSet reducers = make_reducers();
+            TrajectorySink* sink = use_csv ? static_cast<TrajectorySink*>(&csv) : &reducers;
+            {
+                FailingLorenz failing(fail_after);
+                Integrator interrupted(failing, 0.01);
+                configure(interrupted);
+                interrupted.setSink(sink, 64);
+                interrupted.setCheckpoint(checkpoint, 250);
+                Vec y = y0;
+                try {
+                    interrupted.integrate(y, 0.0, 30.0);
+                    std::cerr << "Streamed integration was not interrupted" << std::endl;
+                    return 1;
+                } catch (const std::runtime_error&) {
+                }
+            }
+
+            Lorenz fresh;
+            Integrator resumed(fresh, 0.01);
+            configure(resumed);
+            resumed.setSink(sink, 64);
+            Vec y;
+            resumed.resume(y, checkpoint);
+            const bool same = use_csv ? readFile(csv_out) == readFile(csv_ref)
+                                      : (reducers.result() - expected_stats).cwiseAbs().maxCoeff() <= 1e-12;
+            if (y != y_ref || !same) {
+                std::cerr << "Resumed " << (use_csv ? "CSV" : "reducer") << " sink differs from the reference"
+                          << " (failure after " << fail_after << " rhs calls)" << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::remove(csv_ref.c_str());
+    std::remove(csv_out.c_str());
+
+    // Checkpoints of an older format version are rejected as such, not misparsed
+    {
+        std::vector<char> bytes;
+        {
+            std::ifstream in(checkpoint, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        const std::uint32_t old_version = 2;
+        std::memcpy(bytes.data() + 8, &old_version, sizeof(old_version));  // Version follows the 8-byte magic
+        std::ofstream(checkpoint, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        Lorenz fresh;
+        Integrator resumed(fresh, 0.01);
+        configure(resumed);
+        Vec y;
+        try {
+            resumed.resume(y, checkpoint);
+            std::cerr << "Checkpoint of an older version was accepted" << std::endl;
+            return 1;
+        } catch (const std::runtime_error& e) {
+            if (std::string(e.what()).find("version") == std::string::npos) {
+                std::cerr << "Unexpected error for an older checkpoint: " << e.what() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // Sweep interrupted at point 12: only the remaining points are evaluated on resume
+    DampedOscillator oscillator(1.0, 0.1);
+    ParameterSweep sweep(oscillator, "omega");
+    sweep.setParameterRange(0.5, 2.0, 20);
+    sweep.setTimeStep(0.01);
+    sweep.setOutputInterval(0.1);
+    int calls = 0;
+    bool fail = false;
+    sweep.setPointFunction([&](AbstractDynamicalSystem& system, const Vec& y, double t0, double tf) {
+        if (fail && calls == 12) throw std::runtime_error("preempted");
+        ++calls;
+        Integrator integrator(system, 0.01);
+        Vec state = y;
+        integrator.integrate(state, t0, tf);
+        return state;
+    });
+
+    Vec y_osc(2);
+    y_osc << 1.0, 0.0;
+    sweep.runSweep(y_osc, 0.0, 20.0);
+    const Mat expected = sweep.getProcessedResults();
+
+    sweep.setCheckpoint(checkpoint, 1);
+    fail = true;
+    calls = 0;
+    try {
+        sweep.runSweep(y_osc, 0.0, 20.0);
+        std::cerr << "Sweep was not interrupted" << std::endl;
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+    fail = false;
+    calls = 0;
+    sweep.resumeSweep(y_osc, 0.0, 20.0);
+    if (calls != 8 || sweep.getProcessedResults() != expected) {
+        std::cerr << "Resumed sweep evaluated " << calls << " points or differs from the reference" << std::endl;
+        return 1;
+    }
+
+    // Threaded sweep checkpointing after every point: the last checkpoint holds every result,
+    // so resuming it evaluates nothing
+    auto final_state = [](const Mat& result) -> Vec { return result.col(result.cols() - 1); };
+    ParameterSweep threaded(oscillator, "omega");
+    threaded.setParameterRange(0.5, 2.0, 40);
+    threaded.setTimeStep(0.01);
+    threaded.setOutputInterval(0.1);
+    threaded.setPostProcessingFunction(final_state);
+    threaded.setNumThreads(4);
+    threaded.setCheckpoint(checkpoint, 1);
+    threaded.runSweep(y_osc, 0.0, 20.0);
+
+    std::atomic<int> evaluated{0};
+    ParameterSweep restored(oscillator, "omega");
+    restored.setParameterRange(0.5, 2.0, 40);
+    restored.setTimeStep(0.01);
+    restored.setOutputInterval(0.1);
+    restored.setPostProcessingFunction([&](const Mat& result) {
+        ++evaluated;
+        return final_state(result);
+    });
+    restored.setCheckpoint(checkpoint, 1);
+    restored.resumeSweep(y_osc, 0.0, 20.0);
+    if (evaluated != 0 || restored.getProcessedResults() != threaded.getProcessedResults()) {
+        std::cerr << "Checkpoint of the threaded sweep is incomplete" << std::endl;
+        return 1;
+    }
+
+    std::remove(checkpoint.c_str());
+    std::remove((checkpoint + ".samples").c_str());
+    std::cout << "Checkpoint test passed" << std::endl;
+    return 0;
+}
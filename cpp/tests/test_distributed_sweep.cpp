@@ -0,0 +1,129 @@
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Definitions.hpp"
+#include "GridSweep.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Coordinator and forked worker processes on one machine: one worker crashes and one hangs
+// on its first chunk; both chunks are re-dispatched and the merged store matches a local sweep.
+int main() {
+    DampedOscillator oscillator(1.0, 0.1);
+    Vec y0(2);
+    y0 << 1.0, 0.0;
+    auto final_amplitude = [](const Mat& result) {
+        Vec out(2);
+        out << result.col(result.cols() - 1).norm(), result.row(0).maxCoeff();
+        return out;
+    };
+
+    GridSweep sweep(oscillator);
+    sweep.addAxis("omega", 0.5, 2.0, 20);
+    sweep.addAxis("gamma", 0.0, 0.5, 15);
+    sweep.setTimeStep(0.01);
+    sweep.setOutputInterval(0.1);
+    sweep.setPostProcessingFunction(final_amplitude);
+    sweep.runSweep(y0, 0.0, 10.0);
+    const Mat expected = sweep.getResults().readAll();
+
+    const auto temp = std::filesystem::temp_directory_path();
+    const std::string socket_path = (temp / ("nldkit_test_" + std::to_string(::getpid()) + ".sock")).string();
+    const std::string store_file = (temp / "nldkit_test_distributed.nldkres").string();
+
+    // Worker roles: 0 crashes, 1 hangs, 2 and 3 (threaded) finish the sweep. Once they hold a
+    // chunk, the faulty workers write a byte to the `ready` pipe of each of the others, which
+    // wait for both bytes, so the coordinator sees the same sequence of events on every run.
+    int ready[2][2];
+    if (::pipe(ready[0]) != 0 || ::pipe(ready[1]) != 0) {
+        std::cerr << "pipe failed" << std::endl;
+        return 1;
+    }
+    auto signal_ready = [&ready] {
+        for (auto& fds : ready) (void)!::write(fds[1], "r", 1);
+    };
+    std::vector<pid_t> workers;
+    for (int role = 0; role < 4; ++role) {
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            std::cerr << "fork failed" << std::endl;
+            return 1;
+        }
+        if (pid > 0) {
+            workers.push_back(pid);
+            continue;
+        }
+        try {
+            if (role == 0) {
+                sweep.setPostProcessingFunction([&](const Mat&) -> Vec {
+                    signal_ready();
+                    ::_exit(3);
+                });
+            } else if (role == 1) {
+                sweep.setPostProcessingFunction([&](const Mat&) -> Vec {
+                    signal_ready();
+                    std::this_thread::sleep_for(std::chrono::seconds(60));
+                    ::_exit(4);
+                });
+            } else {
+                // Let the faulty workers take their chunks first
+                const int fd = ready[role - 2][0];
+                for (auto& fds : ready) ::close(fds[1]);
+                char bytes[2];
+                for (std::size_t got = 0; got < sizeof(bytes);) {
+                    ssize_t n = ::read(fd, bytes + got, sizeof(bytes) - got);
+                    if (n <= 0) throw std::runtime_error("faulty workers did not take a chunk");
+                    got += static_cast<std::size_t>(n);
+                }
+                sweep.setNumThreads(role == 3 ? 2 : 1);
+            }
+            sweep.runWorker(socket_path, y0, 0.0, 10.0);
+            ::_exit(0);
+        } catch (const std::exception& e) {
+            std::cerr << "Worker " << role << ": " << e.what() << std::endl;
+            ::_exit(1);
+        }
+    }
+
+    for (auto& fds : ready) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    SweepCoordinator::Stats stats;
+    {
+        ResultStore store(store_file, 64);
+        sweep.setResultStore(&store);
+        stats = sweep.runCoordinator(socket_path, 16, 1.0);
+    }
+    ::kill(workers[1], SIGKILL);
+
+    int status[4];
+    for (int role = 0; role < 4; ++role) ::waitpid(workers[role], &status[role], 0);
+
+    auto merged = ResultStore::open(store_file);
+    if (merged->readAll() != expected || merged->coordinates() != sweep.generatePoints()) {
+        std::cerr << "Distributed results differ from the local sweep" << std::endl;
+        return 1;
+    }
+    if (stats.chunks != 19 || stats.workers != 4 || stats.failed_workers != 2 || stats.redispatched != 2
+        || stats.dispatched != 21) {
+        std::cerr << "Unexpected coordinator stats: " << stats.dispatched << " dispatched, "
+                  << stats.redispatched << " re-dispatched, " << stats.failed_workers << " failed" << std::endl;
+        return 1;
+    }
+    if (!WIFEXITED(status[0]) || WEXITSTATUS(status[0]) != 3 || !WIFEXITED(status[2]) || WEXITSTATUS(status[2]) != 0
+        || !WIFEXITED(status[3]) || WEXITSTATUS(status[3]) != 0) {
+        std::cerr << "Workers did not exit as expected" << std::endl;
+        return 1;
+    }
+    std::remove(store_file.c_str());
+
+    std::cout << "Distributed sweep test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include "Definitions.hpp"
+#include "EnsembleIntegrator.hpp"
+#include "Integrator.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Every ensemble member reproduces Integrator: same samples, times and final state, with and
+// without output recording.
+int main() {
+    DampedOscillator oscillator(1.5, 0.1);
+    const Index members = 3;
+    BatchMat Y0(2, members);
+    Y0 << 1.0, 0.5, -2.0,
+          0.5, 0.0, 1.0;
+
+    for (double interval : {0.1, 0.037, -1.0}) {
+        EnsembleIntegrator ensemble(oscillator, 0.01);
+        ensemble.setTransientTime(2.0);
+        ensemble.setOutputInterval(interval);
+        BatchMat Y = Y0;
+        ensemble.integrate(Y, 0.0, 10.0);
+
+        for (Index m = 0; m < members; ++m) {
+            Integrator single(oscillator, 0.01);
+            single.setTransientTime(2.0);
+            single.setOutputInterval(interval);
+            Vec y = Y0.col(m).transpose();
+            single.integrate(y, 0.0, 10.0);
+
+            const Mat& expected = single.getResults();
+            const Mat member = ensemble.getMemberResults(m);
+            if (member.cols() != expected.cols() || ensemble.getTimes().size() != single.getTimes().size()) {
+                std::cerr << "Interval " << interval << ": sample counts differ (" << member.cols() << " vs "
+                          << expected.cols() << ")" << std::endl;
+                return 1;
+            }
+            if (member.cols() > 0 && ((member - expected).cwiseAbs().maxCoeff() > 1e-12
+                                      || (ensemble.getTimes() - single.getTimes()).cwiseAbs().maxCoeff() > 1e-12)) {
+                std::cerr << "Interval " << interval << ": samples or times of member " << m << " differ" << std::endl;
+                return 1;
+            }
+            if ((Y.col(m).transpose() - y).cwiseAbs().maxCoeff() > 1e-12) {
+                std::cerr << "Interval " << interval << ": final state of member " << m << " differs" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "Ensemble integrator test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <cmath>
+#include <iostream>
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Undamped oscillator x(t) = cos(t): checks section crossings and a terminal event.
+int main() {
+    DampedOscillator oscillator(1.0, 0.0);
+
+    // Poincaré section x = 0, crossed upwards at t = 3 pi / 2 + 2 pi k
+    Vec y(2);
+    y << 1.0, 0.0;
+    Integrator integrator(oscillator, 0.01);
+    integrator.addEvent({[](double t, const Vec& state) { return state[0]; }, Event::Direction::Rising});
+    integrator.integrate(y, 0.0, 100.0);
+
+    Vec times = integrator.getEventTimes();
+    Mat states = integrator.getEventStates();
+    if (integrator.getResults().cols() != 0 || times.size() != 16 || integrator.terminated()) {
+        std::cerr << "Unexpected number of crossings: " << times.size() << std::endl;
+        return 1;
+    }
+    for (Index k = 0; k < times.size(); ++k) {
+        double expected = 1.5 * Constants::PI + k * Constants::TWO_PI;
+        if (std::abs(times(k) - expected) > 1e-7 || std::abs(states(0, k)) > 1e-7
+            || std::abs(states(1, k) - 1.0) > 1e-7) {
+            std::cerr << "Crossing " << k << " at t = " << times(k) << ", expected " << expected << std::endl;
+            return 1;
+        }
+    }
+
+    // Terminal event at x = -0.5 (t = 2 pi / 3); integration must stop there
+    y << 1.0, 0.0;
+    Integrator terminal(oscillator, 0.01);
+    terminal.setOutputInterval(0.1);
+    terminal.addEvent({[](double t, const Vec& state) { return state[0] + 0.5; }, Event::Direction::Falling, true});
+    terminal.integrate(y, 0.0, 100.0);
+
+    const double t_stop = 2.0 * Constants::PI / 3.0;
+    if (!terminal.terminated() || std::abs(terminal.getFinalTime() - t_stop) > 1e-7
+        || std::abs(y(0) + 0.5) > 1e-7 || terminal.getTimes().size() == 0
+        || terminal.getTimes()(terminal.getTimes().size() - 1) > t_stop) {
+        std::cerr << "Terminal event did not stop the integration at t = " << t_stop << std::endl;
+        return 1;
+    }
+
+    std::cout << "Event test passed" << std::endl;
+    return 0;
+}
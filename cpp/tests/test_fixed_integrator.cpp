@@ -0,0 +1,46 @@
+#include <iostream>
+#include "Definitions.hpp"
+#include "FixedIntegrator.hpp"
+#include "Integrator.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// The compile-time integrator reproduces Integrator: same samples, times and final state,
+// with and without output recording.
+int main() {
+    DampedOscillator oscillator(1.5, 0.1);
+    Vec y0(2);
+    y0 << 1.0, 0.5;
+
+    for (double interval : {0.1, 0.037, -1.0}) {
+        Integrator dynamic(oscillator, 0.01);
+        dynamic.setTransientTime(2.0);
+        dynamic.setOutputInterval(interval);
+        FixedIntegrator<DampedOscillator, 2> fixed(oscillator, 0.01);
+        fixed.setTransientTime(2.0);
+        fixed.setOutputInterval(interval);
+
+        Vec a = y0, b = y0;
+        dynamic.integrate(a, 0.0, 10.0);
+        fixed.integrate(b, 0.0, 10.0);
+
+        const Mat& ra = dynamic.getResults();
+        const Mat& rb = fixed.getResults();
+        if (ra.cols() != rb.cols() || dynamic.getTimes().size() != fixed.getTimes().size()) {
+            std::cerr << "Interval " << interval << ": sample counts differ (" << ra.cols() << " vs "
+                      << rb.cols() << ")" << std::endl;
+            return 1;
+        }
+        if (ra.cols() > 0 && ((ra - rb).cwiseAbs().maxCoeff() > 1e-12
+                              || (dynamic.getTimes() - fixed.getTimes()).cwiseAbs().maxCoeff() > 1e-12)) {
+            std::cerr << "Interval " << interval << ": samples or times differ" << std::endl;
+            return 1;
+        }
+        if ((a - b).cwiseAbs().maxCoeff() > 1e-12) {
+            std::cerr << "Interval " << interval << ": final states differ" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Fixed integrator test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include "Definitions.hpp"
+#include "GridSweep.hpp"
+#include "ResultStore.hpp"
+#include "Integrator.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// omega × gamma map of the oscillator: in memory, spilled to disk and read while running
+int main() {
+    DampedOscillator oscillator(1.0, 0.1);
+    Vec y0(2);
+    y0 << 1.0, 0.0;
+    auto final_amplitude = [](const Mat& result) {
+        Vec out(1);
+        out(0) = result.col(result.cols() - 1).norm();
+        return out;
+    };
+
+    GridSweep memory(oscillator);
+    memory.addAxis("omega", 0.5, 2.0, 20);
+    memory.addAxis("gamma", 0.0, 0.5, 15);
+    memory.setTimeStep(0.01);
+    memory.setOutputInterval(0.1);
+    memory.setPostProcessingFunction(final_amplitude);
+    memory.runSweep(y0, 0.0, 10.0);
+
+    // Point (omega index 7, gamma index 11) against a direct integration
+    const ResultStore& results = memory.getResults();
+    const Index point = 7 + 20 * 11;
+    DampedOscillator direct(0.5 + 7 * 1.5 / 19, 11 * 0.5 / 14);
+    Integrator integrator(direct, 0.01);
+    integrator.setOutputInterval(0.1);
+    Vec y = y0;
+    integrator.integrate(y, 0.0, 10.0);
+    if (results.numPoints() != 300 || results.coordinates()(0, point) != direct.getParameter("omega")
+        || results.readPoints(point, 1)(0, 0) != final_amplitude(integrator.getResults())(0)) {
+        std::cerr << "Grid point " << point << " differs from a direct integration" << std::endl;
+        return 1;
+    }
+
+    // Spilling store on 3 threads; completed chunks are readable while the sweep runs
+    const std::string store_file = (std::filesystem::temp_directory_path() / "nldkit_test_grid.nldkres").string();
+    ResultStore spill(store_file, 64);
+    GridSweep spilled(oscillator);
+    spilled.addAxis("omega", 0.5, 2.0, 20);
+    spilled.addAxis("gamma", 0.0, 0.5, 15);
+    spilled.setTimeStep(0.01);
+    spilled.setOutputInterval(0.1);
+    spilled.setPostProcessingFunction(final_amplitude);
+    spilled.setResultStore(&spill);
+    spilled.setNumThreads(3);
+    spilled.runSweep(y0, 0.0, 10.0);
+
+    auto reader = ResultStore::open(store_file);
+    if (reader->numChunks() != 5 || reader->axisNames()[1] != "gamma"
+        || reader->readAll() != results.readAll() || reader->coordinates() != results.coordinates()) {
+        std::cerr << "Spilled results differ from the in-memory store" << std::endl;
+        return 1;
+    }
+
+    bool read_while_running = false;
+    GridSweep watched(oscillator);
+    watched.addAxis("omega", 0.5, 2.0, 300);
+    watched.setResultStore(&spill);
+    watched.setPointFunction([&](AbstractDynamicalSystem& system, const Vec& state, double t0, double tf) {
+        if (system.getParameter("omega") == 2.0) {  // Last point: every earlier chunk is on disk
+            auto partial = ResultStore::open(store_file);
+            read_while_running = partial->isChunkComplete(3) && !partial->isChunkComplete(4)
+                && partial->readChunk(3).cols() == 64;
+        }
+        return Vec::Constant(1, system.getParameter("omega"));
+    });
+    watched.runSweep(y0, 0.0, 1.0);
+    if (!read_while_running) {
+        std::cerr << "Completed chunks were not readable during the sweep" << std::endl;
+        return 1;
+    }
+
+    // Chunks left incomplete are written by end() but never reported as complete
+    {
+        ResultStore partial(store_file, 4);
+        partial.begin(1, Mat::Zero(1, 10), {"omega"});
+        for (Index point : {0, 1, 2, 3, 4, 6}) partial.store(point, Vec::Constant(1, point));
+        partial.end();
+    }
+    auto incomplete = ResultStore::open(store_file);
+    bool rejected = false;
+    try {
+        incomplete->readChunk(1);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    if (!incomplete->isChunkComplete(0) || incomplete->isChunkComplete(1) || incomplete->isChunkComplete(2)
+        || !rejected || incomplete->readChunk(0)(0, 3) != 3.0) {
+        std::cerr << "Incomplete chunks were reported as complete" << std::endl;
+        return 1;
+    }
+    std::remove(store_file.c_str());
+
+    // Sobol points: known start of the 2-D sequence, scaled to the axis ranges
+    GridSweep sobol(oscillator);
+    sobol.addAxis("omega", 0.0, 2.0, 1);
+    sobol.addAxis("gamma", 0.0, 1.0, 1);
+    sobol.setSampling(GridSweep::Sampling::Sobol, 4);
+    Mat expected(2, 4);
+    expected << 1.0, 1.5, 0.5, 0.75,
+                0.5, 0.25, 0.75, 0.375;
+    if (sobol.generatePoints() != expected) {
+        std::cerr << "Unexpected Sobol points" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Grid sweep test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <cmath>
+#include <iostream>
+#include "Definitions.hpp"
+#include "LyapunovSpectrum.hpp"
+#include "ParameterSweep.hpp"
+#include "systems/DampedOscillator.hpp"
+#include "systems/Lorenz.hpp"
+
+// Lorenz without its analytic Jacobian
+class FiniteDifferenceLorenz : public AbstractDynamicalSystem {
+public:
+    FiniteDifferenceLorenz() {
+        dim = 3;
+    }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        lorenz_.rhs(t, y, dydt);
+    }
+
+private:
+    Lorenz lorenz_;
+};
+
+int main() {
+    // Lorenz attractor: lambda_1 ~ 0.906, lambda_2 = 0, sum = -(sigma + 1 + beta)
+    Lorenz lorenz;
+    Vec y(3);
+    y << 1.0, 1.0, 1.0;
+    LyapunovSpectrum spectrum(lorenz, 0.005);
+    spectrum.setTransientTime(20.0);
+    spectrum.setReorthonormalizationInterval(0.5);
+    const Vec& exponents = spectrum.compute(y, 0.0, 1000.0);
+    std::cout << "Lorenz spectrum: " << exponents.transpose() << std::endl;
+    if (std::abs(exponents(0) - 0.906) > 0.1 || std::abs(exponents(1)) > 0.05
+        || std::abs(exponents.sum() + (10.0 + 1.0 + 8.0 / 3.0)) > 0.05) {
+        std::cerr << "Lorenz spectrum out of range" << std::endl;
+        return 1;
+    }
+
+    // The default finite-difference Jacobian must agree with the analytic one
+    DampedOscillator oscillator(1.3, 0.2);
+    Vec x(2);
+    x << 0.4, -0.7;
+    Mat J_analytic, J_fd;
+    oscillator.jacobian(0.0, x, J_analytic);
+    oscillator.AbstractDynamicalSystem::jacobian(0.0, x, J_fd);
+    if ((J_analytic - J_fd).cwiseAbs().maxCoeff() > 1e-6) {
+        std::cerr << "Finite-difference Jacobian mismatch" << std::endl;
+        return 1;
+    }
+
+    // A system without an analytic Jacobian takes the finite-difference path, which reuses
+    // the base derivative of the variational equations
+    FiniteDifferenceLorenz fd_lorenz;
+    Vec y_short(3), y_fd(3);
+    y_short << 1.0, 1.0, 1.0;
+    y_fd = y_short;
+    LyapunovSpectrum analytic_short(lorenz, 0.005);
+    LyapunovSpectrum fd_short(fd_lorenz, 0.005);
+    const Vec exact = analytic_short.compute(y_short, 0.0, 20.0);
+    const Vec approx = fd_short.compute(y_fd, 0.0, 20.0);
+    if ((exact - approx).cwiseAbs().maxCoeff() > 1e-3) {
+        std::cerr << "Finite-difference spectrum differs: " << approx.transpose() << std::endl;
+        return 1;
+    }
+
+    // Damped oscillator: both exponents equal -gamma; map the largest over a gamma sweep
+    ParameterSweep sweep(oscillator, "gamma");
+    sweep.setParameterRange(0.05, 0.5, 10);
+    sweep.setPointFunction(LyapunovSpectrum::sweepFunction(0.01, 0.0, 1.0, 1));
+    sweep.setNumThreads(3);
+    Vec y0(2);
+    y0 << 1.0, 0.0;
+    sweep.runSweep(y0, 0.0, 200.0);
+    const Mat& largest = sweep.getProcessedResults();
+    for (Index i = 0; i < largest.cols(); ++i) {
+        double gamma = sweep.getParameterValues()[i];
+        if (std::abs(largest(0, i) + gamma) > 0.01) {
+            std::cerr << "Largest exponent " << largest(0, i) << " does not match -gamma = " << -gamma << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Lyapunov test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "Definitions.hpp"
+#include "NetworkSystem.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Ring of N diffusively coupled oscillators: x_i'' = -2 gamma x_i' - omega^2 x_i
+// + k (x_{i-1} - 2 x_i + x_{i+1}), coupling the positions into the velocity equations.
+static SparseMat ringLaplacian(int n) {
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int i = 0; i < n; ++i) {
+        entries.emplace_back(i, (i + n - 1) % n, 1.0);
+        entries.emplace_back(i, i, -2.0);
+        entries.emplace_back(i, (i + 1) % n, 1.0);
+    }
+    SparseMat laplacian(n, n);
+    laplacian.setFromTriplets(entries.begin(), entries.end());
+    return laplacian;
+}
+
+int main() {
+    const double omega = 1.3, gamma = 0.05, k = 0.4;
+
+    // Right-hand side against the explicit formula (several blocks, 1 and 4 threads)
+    const int n = 5000;
+    NetworkSystem<DampedOscillator, 2> network(DampedOscillator(omega, gamma), ringLaplacian(n), k, 0, 1);
+    Vec y = Vec::Random(network.dim);
+    Vec serial(network.dim), threaded(network.dim);
+    network.rhs(0.0, y, serial);
+    network.setNumThreads(4);
+    network.rhs(0.0, y, threaded);
+
+    double max_error = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double x = y[2 * i], v = y[2 * i + 1];
+        double laplacian = y[2 * ((i + n - 1) % n)] - 2.0 * x + y[2 * ((i + 1) % n)];
+        max_error = std::max(max_error, std::abs(serial[2 * i] - v));
+        max_error = std::max(max_error, std::abs(serial[2 * i + 1]
+            - (-2.0 * gamma * v - omega * omega * x + k * laplacian)));
+    }
+    if (max_error > 1e-12 || serial != threaded) {
+        std::cerr << "Network rhs mismatch: max error " << max_error << std::endl;
+        return 1;
+    }
+
+    // Parameters: "coupling" belongs to the network, other names reach the node
+    network.setParameter("omega", 2.0);
+    if (network.getParameter("omega") != 2.0 || network.getParameter("coupling") != k
+        || network.getParameterHandle("gamma") != DampedOscillator::GAMMA + 1) {
+        std::cerr << "Parameter forwarding failed" << std::endl;
+        return 1;
+    }
+
+    // Sparse Jacobian against finite differences on a small network
+    NetworkSystem<DampedOscillator> small(DampedOscillator(omega, gamma), ringLaplacian(6), k, 0, 1);
+    Vec y_small = Vec::Random(small.dim);
+    SparseMat J;
+    Mat J_fd;
+    small.sparseJacobian(0.0, y_small, J);
+    small.AbstractDynamicalSystem::jacobian(0.0, y_small, J_fd);
+    if ((Mat(J) - J_fd).cwiseAbs().maxCoeff() > 1e-6) {
+        std::cerr << "Network Jacobian mismatch" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Network system test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <cmath>
+#include <iostream>
+#include "Definitions.hpp"
+#include "DynamicalSystem.hpp"
+#include "ParameterSweep.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Bistable normal form x' = r + x - x^3: two stable branches coexist for |r| < 2 / (3 sqrt 3)
+class Bistable : public DynamicalSystem {
+public:
+    Bistable() {
+        dim = 1;
+        defineParameter("r", 0.0);
+    }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        dydt[0] = parameters_[0] + y[0] - y[0] * y[0] * y[0];
+    }
+
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<Bistable>(*this);
+    }
+};
+
+// Runs the same sweep serially and on several threads; both must agree bit for bit.
+int main() {
+    DampedOscillator oscillator(1.0, 0.1);
+
+    Vec y0(2);
+    y0(0) = 1.0;
+    y0(1) = 0.0;
+
+    auto max_amplitude = [](const Mat& result) {
+        Vec out(1);
+        out(0) = result.row(0).cwiseAbs().maxCoeff();
+        return out;
+    };
+
+    ParameterSweep serial(oscillator, "gamma");
+    serial.setParameterRange(0.0, 0.5, 37);
+    serial.setTimeStep(0.01);
+    serial.setTransientTime(5.0);
+    serial.setOutputInterval(0.1);
+    serial.setPostProcessingFunction(max_amplitude);
+    serial.runSweep(y0, 0.0, 20.0);
+
+    ParameterSweep threaded(oscillator, "gamma");
+    threaded.setParameterRange(0.0, 0.5, 37);
+    threaded.setTimeStep(0.01);
+    threaded.setTransientTime(5.0);
+    threaded.setOutputInterval(0.1);
+    threaded.setPostProcessingFunction(max_amplitude);
+    threaded.setNumThreads(4);
+    threaded.runSweep(y0, 0.0, 20.0);
+
+    const Mat& a = serial.getProcessedResults();
+    const Mat& b = threaded.getProcessedResults();
+    if (a.rows() != 1 || a.cols() != 37 || a != b) {
+        std::cerr << "Threaded sweep differs from serial sweep" << std::endl;
+        return 1;
+    }
+    // Undamped oscillation keeps its unit amplitude; strong damping removes most of it.
+    if (std::abs(a(0, 0) - 1.0) > 1e-2 || a(0, 36) > 0.1) {
+        std::cerr << "Unexpected amplitudes: " << a(0, 0) << ", " << a(0, 36) << std::endl;
+        return 1;
+    }
+
+    // The SIMD ensemble backend must reproduce the scalar backend
+    ParameterSweep ensemble(oscillator, "gamma");
+    ensemble.setParameterRange(0.0, 0.5, 37);
+    ensemble.setTimeStep(0.01);
+    ensemble.setTransientTime(5.0);
+    ensemble.setOutputInterval(0.1);
+    ensemble.setPostProcessingFunction(max_amplitude);
+    ensemble.setBackend(ParameterSweep::Backend::Ensemble, 8);
+    ensemble.setNumThreads(2);
+    ensemble.runSweep(y0, 0.0, 20.0);
+
+    const Mat& c = ensemble.getProcessedResults();
+    if (c.cols() != 37 || (a - c).cwiseAbs().maxCoeff() > 1e-12) {
+        std::cerr << "Ensemble sweep differs from scalar sweep" << std::endl;
+        return 1;
+    }
+
+    // Batched post-processing (uneven last batch, 3 threads) matches the per-point function
+    ParameterSweep batched(oscillator, "gamma");
+    batched.setParameterRange(0.0, 0.5, 37);
+    batched.setTimeStep(0.01);
+    batched.setTransientTime(5.0);
+    batched.setOutputInterval(0.1);
+    batched.setNumThreads(3);
+    Index batch_calls = 0;
+    batched.setBatchPostProcessingFunction([&](const Mat& trajectories, Index count) {
+        ++batch_calls;
+        const Index num_samples = trajectories.cols() / count;
+        Mat out(1, count);
+        for (Index j = 0; j < count; ++j) {
+            out(0, j) = max_amplitude(trajectories.middleCols(j * num_samples, num_samples))(0);
+        }
+        return out;
+    }, 8);
+    batched.runSweep(y0, 0.0, 20.0);
+    if (batch_calls != 5 || batched.getProcessedResults() != a) {
+        std::cerr << "Batched post-processing differs from per-point post-processing" << std::endl;
+        return 1;
+    }
+
+    // An ensemble sweep over another parameter (same block size, same system) must
+    // not reuse the per-member values of the first one
+    ParameterSweep omega_ensemble(oscillator, "omega");
+    ParameterSweep omega_scalar(oscillator, "omega");
+    for (ParameterSweep* sweep : {&omega_ensemble, &omega_scalar}) {
+        sweep->setParameterRange(0.5, 2.0, 37);
+        sweep->setTimeStep(0.01);
+        sweep->setTransientTime(5.0);
+        sweep->setOutputInterval(0.1);
+        sweep->setPostProcessingFunction(max_amplitude);
+    }
+    omega_ensemble.setBackend(ParameterSweep::Backend::Ensemble, 8);
+    omega_ensemble.runSweep(y0, 0.0, 20.0);
+    omega_scalar.runSweep(y0, 0.0, 20.0);
+    if ((omega_ensemble.getProcessedResults() - omega_scalar.getProcessedResults()).cwiseAbs().maxCoeff() > 1e-12) {
+        std::cerr << "Second ensemble sweep used stale per-member parameters" << std::endl;
+        return 1;
+    }
+
+    // Continuation in both directions exposes the hysteresis loop and skips most transients
+    Bistable bistable;
+    ParameterSweep continuation(bistable, "r");
+    continuation.setParameterRange(-1.0, 1.0, 41);
+    continuation.setTimeStep(0.01);
+    continuation.setTransientTime(50.0);
+    continuation.setOutputInterval(0.1);
+    continuation.setPostProcessingFunction([](const Mat& result) {
+        Vec out(1);
+        out(0) = result.row(0).mean();
+        return out;
+    });
+    continuation.setContinuation(ParameterSweep::Continuation::Both, 1e-8);
+    continuation.setNumThreads(2);
+    Vec x0 = Vec::Zero(1);
+    continuation.runSweep(x0, 0.0, 60.0);
+
+    const Mat& forward = continuation.getProcessedResults();
+    const Mat& backward = continuation.getBackwardResults();
+    const ParameterSweep::SweepStats& stats = continuation.getStats();
+    if (forward.cols() != 41 || backward.cols() != 41 || forward(0, 20) > -0.9 || backward(0, 20) < 0.9
+        || std::abs(forward(0, 0) - backward(0, 0)) > 1e-6 || std::abs(forward(0, 40) - backward(0, 40)) > 1e-6) {
+        std::cerr << "Continuation did not reproduce the hysteresis loop" << std::endl;
+        return 1;
+    }
+    if (stats.points != 82 || stats.warm_started != 80 || stats.transientSavings() < 0.5) {
+        std::cerr << "Unexpected continuation statistics: savings " << stats.transientSavings() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Parameter sweep test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include "Definitions.hpp"
+#include "DynamicalSystem.hpp"
+#include "ParameterSweep.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Relaxation x' = -k x declared with the registry
+class Relaxation : public DynamicalSystem {
+public:
+    static constexpr ParamHandle K = 0;
+
+    Relaxation() {
+        dim = 1;
+        defineParameter("k", 1.0);
+    }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        dydt[0] = -parameters_[K] * y[0];
+    }
+
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<Relaxation>(*this);
+    }
+
+    void defineTwice() {
+        defineParameter("k", 2.0);
+    }
+};
+
+// The same system in the style that predates the registry: parameters are set by name in
+// the constructor, through the explicit opt-in
+class LegacyRelaxation : public DynamicalSystem {
+public:
+    LegacyRelaxation() {
+        dim = 1;
+        declareOrSet("k", 1.0);
+        declareOrSet("k", 1.0);  // Setting it again updates the value
+    }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        dydt[0] = -getParameter("k") * y[0];
+    }
+
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<LegacyRelaxation>(*this);
+    }
+};
+
+// A system implementing only the by-name accessors, without handles
+class NameOnlyRelaxation : public AbstractDynamicalSystem {
+public:
+    NameOnlyRelaxation() {
+        dim = 1;
+    }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        dydt[0] = -k_ * y[0];
+    }
+
+    void setParameter(const std::string& name, double value) override {
+        if (name != "k") throw std::invalid_argument("Unknown parameter: " + name);
+        k_ = value;
+    }
+
+    double getParameter(const std::string& name) const override {
+        if (name != "k") throw std::invalid_argument("Unknown parameter: " + name);
+        return k_;
+    }
+
+    std::unique_ptr<AbstractDynamicalSystem> clone() const override {
+        return std::make_unique<NameOnlyRelaxation>(*this);
+    }
+
+private:
+    double k_ = 1.0;
+};
+
+template <typename Func>
+bool throws(Func func) {
+    try {
+        func();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+// Handle registry: declaration, lookup, errors, the by-name compatibility layer, and sweeps
+// of systems with and without handles.
+int main() {
+    DampedOscillator oscillator(1.5, 0.2);
+    if (oscillator.getParameterHandle("omega") != DampedOscillator::OMEGA
+        || oscillator.getParameterHandle("gamma") != DampedOscillator::GAMMA
+        || oscillator.getParameter(DampedOscillator::OMEGA) != 1.5 || oscillator.getParameter("gamma") != 0.2) {
+        std::cerr << "Handles or values of declared parameters are wrong" << std::endl;
+        return 1;
+    }
+    oscillator.setParameter(DampedOscillator::GAMMA, 0.3);
+    oscillator.setParameter("omega", 2.5);
+    if (oscillator.getParameter("gamma") != 0.3 || oscillator.getParameter(DampedOscillator::OMEGA) != 2.5) {
+        std::cerr << "By-name and by-handle access disagree" << std::endl;
+        return 1;
+    }
+    auto clone = oscillator.clone();
+    if (clone->getParameterHandle("gamma") != DampedOscillator::GAMMA || clone->getParameter(DampedOscillator::GAMMA) != 0.3) {
+        std::cerr << "Clone does not share the handles" << std::endl;
+        return 1;
+    }
+
+    // Misspelt names are errors, not new parameters
+    if (!throws([&] { oscillator.setParameter("bogus", 1.0); })
+        || !throws([&] { oscillator.setParameter("omgea", 1.0); })
+        || oscillator.getParameter("omega") != 2.5) {
+        std::cerr << "Setting an unknown parameter name was accepted" << std::endl;
+        return 1;
+    }
+
+    Relaxation relaxation;
+    if (!throws([&] { relaxation.defineTwice(); })
+        || !throws([&] { relaxation.getParameterHandle("missing"); })
+        || !throws([&] { relaxation.getParameter("missing"); })
+        || !throws([&] { relaxation.setParameter(ParamHandle(1), 0.0); })
+        || !throws([&] { relaxation.getParameter(ParamHandle(-1)); })) {
+        std::cerr << "Invalid declarations, names or handles were accepted" << std::endl;
+        return 1;
+    }
+
+    // declareOrSet() declares once; public by-name setting still rejects unknown names
+    LegacyRelaxation legacy;
+    if (legacy.getParameterHandle("k") != 0 || legacy.getParameter(ParamHandle(0)) != 1.0
+        || !throws([&] { legacy.getParameterHandle("extra"); })
+        || !throws([&] { legacy.setParameter("extra", 4.0); })) {
+        std::cerr << "declareOrSet() or by-name setParameter misbehaved" << std::endl;
+        return 1;
+    }
+
+    // Systems with and without handles sweep to the same results: x(1) = exp(-k)
+    auto final_value = [](const Mat& result) {
+        Vec out(1);
+        out(0) = result(0, result.cols() - 1);
+        return out;
+    };
+    Mat results[3];
+    Relaxation declared;
+    NameOnlyRelaxation name_only;
+    AbstractDynamicalSystem* systems[3] = {&declared, &legacy, &name_only};
+    for (int s = 0; s < 3; ++s) {
+        ParameterSweep sweep(*systems[s], "k");
+        sweep.setParameterRange(0.5, 2.0, 7);
+        sweep.setTimeStep(0.01);
+        sweep.setOutputInterval(0.5);
+        sweep.setPostProcessingFunction(final_value);
+        sweep.setNumThreads(2);
+        sweep.runSweep(Vec::Ones(1), 0.0, 1.0);
+        results[s] = sweep.getProcessedResults();
+    }
+    if (results[0] != results[1] || results[0] != results[2] || std::abs(results[0](0, 6) - std::exp(-2.0)) > 1e-8) {
+        std::cerr << "Sweeps with and without handles differ" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Parameter registry test passed" << std::endl;
+    return 0;
+}
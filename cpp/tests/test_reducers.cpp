@@ -0,0 +1,114 @@
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "ParameterSweep.hpp"
+#include "Reducer.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Streamed reducers agree with the same statistics computed from the stored trajectory,
+// recover the period and amplitude of an oscillation, and drive a sweep without
+// materialising trajectories.
+int main() {
+    const double omega = 2.0;
+    DampedOscillator oscillator(omega, 0.05);
+    Vec y0(2);
+    y0 << 1.0, 0.0;
+
+    Integrator stored(oscillator, 0.001);
+    stored.setOutputInterval(0.01);
+    Vec y = y0;
+    stored.integrate(y, 0.0, 30.0);
+    const Mat& states = stored.getResults();
+    const Vec& times = stored.getTimes();
+    const Index n = states.cols();
+
+    // Chunks of 97 samples: statistics must carry across chunk boundaries
+    const double f = omega / (2.0 * M_PI);
+    ReducerSet set;
+    set.add(MinMaxReducer()).add(MeanVarianceReducer()).add(PeakReducer(0))
+       .add(HistogramReducer(0, -1.0, 1.0, 8)).add(SpectralReducer(0, {f, 3.0 * f}));
+    Integrator streamed(oscillator, 0.001);
+    streamed.setOutputInterval(0.01);
+    streamed.setSink(&set, 97);
+    y = y0;
+    streamed.integrate(y, 0.0, 30.0);
+    const Vec r = set.result();
+
+    Vec expected(4 + 4 + 4 + 8 + 2);
+    expected.segment(0, 2) = states.rowwise().minCoeff();
+    expected.segment(2, 2) = states.rowwise().maxCoeff();
+    const Vec mean = states.rowwise().mean();
+    expected.segment(4, 2) = mean;
+    expected.segment(6, 2) = (states.colwise() - mean).rowwise().squaredNorm() / static_cast<double>(n);
+    Index peaks = 0;
+    double peak_sum = 0.0, peak_min = 1e300, peak_max = -1e300;
+    for (Index k = 1; k + 1 < n; ++k) {
+        const double x = states(0, k);
+        if (x > states(0, k - 1) && x >= states(0, k + 1)) {
+            ++peaks;
+            peak_sum += x;
+            peak_min = std::min(peak_min, x);
+            peak_max = std::max(peak_max, x);
+        }
+    }
+    expected.segment(8, 4) << static_cast<double>(peaks), peak_sum / peaks, peak_min, peak_max;
+    expected.segment(12, 8).setZero();
+    for (Index k = 0; k < n; ++k) {
+        const double x = states(0, k);
+        if (x >= -1.0 && x < 1.0) expected(12 + std::min<Index>(static_cast<Index>((x + 1.0) * 4.0), 7)) += 1.0;
+    }
+    for (int j = 0; j < 2; ++j) {
+        const double freq = (j == 0) ? f : 3.0 * f;
+        std::complex<double> sum = 0.0;
+        for (Index k = 0; k < n; ++k) sum += states(0, k) * std::polar(1.0, -2.0 * M_PI * freq * times(k));
+        expected(20 + j) = std::norm(2.0 * sum / static_cast<double>(n));
+    }
+    if (r.size() != expected.size() || (r - expected).cwiseAbs().maxCoeff() > 1e-9) {
+        std::cerr << "Streamed reducers differ from the stored trajectory:\n"
+                  << r.transpose() << "\n" << expected.transpose() << std::endl;
+        return 1;
+    }
+
+    // Undamped unit oscillation over whole periods: period 2 pi / omega, spectral power 1
+    DampedOscillator undamped(omega, 0.0);
+    ReducerSet harmonic;
+    harmonic.add(PeriodReducer(0)).add(SpectralReducer(0, {f, 3.0 * f}));
+    Integrator integrator(undamped, 0.001);
+    integrator.setOutputInterval(0.01);
+    integrator.setSink(&harmonic, 256);
+    y = y0;
+    integrator.integrate(y, 0.0, 10.0 * M_PI);
+    const Vec h = harmonic.result();
+    if (std::abs(h(0) - M_PI) > 1e-6 || h(1) > 1e-6 || h(2) != 10.0 || std::abs(h(3) - 1.0) > 2e-3 || h(4) > 1e-3) {
+        std::cerr << "Period or spectrum of the oscillation is off: " << h.transpose() << std::endl;
+        return 1;
+    }
+
+    // A reducer sweep matches the same statistic as a post-processing function
+    ParameterSweep reference(oscillator, "gamma");
+    ParameterSweep reduced(oscillator, "gamma");
+    for (ParameterSweep* sweep : {&reference, &reduced}) {
+        sweep->setParameterRange(0.0, 0.5, 23);
+        sweep->setTimeStep(0.01);
+        sweep->setTransientTime(5.0);
+        sweep->setOutputInterval(0.1);
+        sweep->setNumThreads(3);
+    }
+    reference.setPostProcessingFunction([](const Mat& result) {
+        Vec out(4);
+        out << result.rowwise().minCoeff(), result.rowwise().maxCoeff();
+        return out;
+    });
+    reduced.setReducer(MinMaxReducer(), 16);
+    reference.runSweep(y0, 0.0, 20.0);
+    reduced.runSweep(y0, 0.0, 20.0);
+    if (reduced.getProcessedResults() != reference.getProcessedResults()) {
+        std::cerr << "Reducer sweep differs from post-processing sweep" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Reducer test passed" << std::endl;
+    return 0;
+}
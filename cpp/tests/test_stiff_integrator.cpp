@@ -0,0 +1,105 @@
+#include <cmath>
+#include <iostream>
+#include "Definitions.hpp"
+#include "DynamicalSystem.hpp"
+#include "StiffIntegrator.hpp"
+
+// Method-of-lines heat equation u_t = D u_xx on (0, 1) with u = 0 at both ends.
+// Its Jacobian is the constant tridiagonal Laplacian, supplied through sparseJacobian().
+class HeatEquation : public DynamicalSystem {
+public:
+    HeatEquation(int n, double diffusion) : dx_(1.0 / (n + 1)) {
+        dim = n;
+        defineParameter("D", diffusion);
+    }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        const double c = parameters_[0] / (dx_ * dx_);
+        for (int i = 0; i < dim; ++i) {
+            double left = (i > 0) ? y[i - 1] : 0.0;
+            double right = (i < dim - 1) ? y[i + 1] : 0.0;
+            dydt[i] = c * (left - 2.0 * y[i] + right);
+        }
+    }
+
+    void sparseJacobian(double t, const Vec& y, SparseMat& J) override {
+        const double c = parameters_[0] / (dx_ * dx_);
+        std::vector<Eigen::Triplet<double>> entries;
+        entries.reserve(3 * dim);
+        for (int i = 0; i < dim; ++i) {
+            if (i > 0) entries.emplace_back(i, i - 1, c);
+            entries.emplace_back(i, i, -2.0 * c);
+            if (i < dim - 1) entries.emplace_back(i, i + 1, c);
+        }
+        J.resize(dim, dim);
+        J.setFromTriplets(entries.begin(), entries.end());
+    }
+
+    double dx() const { return dx_; }
+
+private:
+    double dx_;
+};
+
+// Robertson chemical kinetics; uses the default finite-difference Jacobian
+class Robertson : public DynamicalSystem {
+public:
+    Robertson() { dim = 3; }
+
+    void rhs(double t, const Vec& y, Vec& dydt) override {
+        dydt[0] = -0.04 * y[0] + 1e4 * y[1] * y[2];
+        dydt[1] = 0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1];
+        dydt[2] = 3e7 * y[1] * y[1];
+    }
+};
+
+int main() {
+    // Heat equation: the sine mode decays as exp(lambda t) with the discrete eigenvalue lambda.
+    // Explicit RK4 would need dt < ~7e-7 here, i.e. more than 10^5 steps.
+    const int n = 1000;
+    const double diffusion = 1.0, tf = 0.1;
+    HeatEquation heat(n, diffusion);
+    Vec u(n);
+    for (int i = 0; i < n; ++i) u[i] = std::sin(Constants::PI * (i + 1) * heat.dx());
+    const Vec u0 = u;
+
+    StiffIntegrator integrator(heat, 1e-6);
+    integrator.setTolerances(1e-5, 1e-8);
+    integrator.setOutputInterval(0.01);
+    integrator.integrate(u, 0.0, tf);
+
+    const double s = std::sin(0.5 * Constants::PI * heat.dx());
+    const double lambda = -4.0 * diffusion * s * s / (heat.dx() * heat.dx());
+    double error = (u - std::exp(lambda * tf) * u0).cwiseAbs().maxCoeff() / std::exp(lambda * tf);
+    const IntegratorStats& stats = integrator.getStats();
+    if (error > 1e-3 || integrator.getResults().cols() != 10) {
+        std::cerr << "Heat equation: relative error " << error << std::endl;
+        return 1;
+    }
+    if (stats.steps_taken > 1000 || stats.factorizations >= stats.steps_taken + stats.steps_rejected) {
+        std::cerr << "Heat equation: " << stats.toJSON() << std::endl;
+        return 1;
+    }
+
+    // Robertson problem (reference values at t = 40 from Hairer & Wanner)
+    Robertson robertson;
+    Vec y(3);
+    y << 1.0, 0.0, 0.0;
+    StiffIntegrator stiff(robertson, 1e-6);
+    stiff.setTolerances(1e-6, 1e-10);
+    stiff.integrate(y, 0.0, 40.0);
+    if (std::abs(y[0] - 0.7158271) > 1e-4 || std::abs(y[1] - 9.185535e-6) > 1e-8
+        || std::abs(y.sum() - 1.0) > 1e-10) {
+        std::cerr << "Robertson: y(40) = " << y.transpose() << std::endl;
+        return 1;
+    }
+
+    // A tiny final step clamped to tf is not a step size underflow
+    HeatEquation small_heat(4, diffusion);
+    Vec rest = Vec::Zero(4);
+    StiffIntegrator short_tail(small_heat, 1.0);
+    short_tail.integrate(rest, 0.0, 1.0 + 5e-12);
+
+    std::cout << "Stiff integrator test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include "Definitions.hpp"
+#include "Event.hpp"
+#include "Integrator.hpp"
+#include "systems/Lorenz.hpp"
+#include "systems/Pendulum.hpp"
+
+using Method = Integrator::Method;
+
+// Convergence orders of the symplectic methods, and bounded energy error on a long run
+// where RK4 at the same step drifts.
+int main() {
+    Pendulum pendulum(1.0);
+    Vec y0(2);
+    y0 << 2.0, 0.0;
+
+    Vec reference = y0;
+    Integrator fine(pendulum, 1e-4);
+    fine.integrate(reference, 0.0, 20.0);
+
+    struct Case { Method method; int order; };
+    for (Case c : {Case{Method::VelocityVerlet, 2}, Case{Method::Yoshida4, 4}, Case{Method::Yoshida6, 6}}) {
+        double error[2];
+        for (int k = 0; k < 2; ++k) {
+            Vec y = y0;
+            Integrator integrator(pendulum, 0.1 / (1 << k));
+            integrator.setMethod(c.method);
+            integrator.integrate(y, 0.0, 20.0);
+            error[k] = (y - reference).norm();
+        }
+        const double observed = std::log2(error[0] / error[1]);
+        if (std::abs(observed - c.order) > 0.3) {
+            std::cerr << "Method " << static_cast<int>(c.method) << ": observed order " << observed
+                      << ", expected " << c.order << std::endl;
+            return 1;
+        }
+    }
+
+    // 5 * 10^5 steps of size 0.2: maximum energy error over samples every 10 time units
+    const double energy0 = pendulum.energy(y0);
+    auto max_energy_error = [&](Method method) {
+        Vec y = y0;
+        Integrator integrator(pendulum, 0.2);
+        integrator.setMethod(method);
+        integrator.setOutputInterval(10.0);
+        integrator.integrate(y, 0.0, 1e5);
+        double max_error = 0.0;
+        const Mat& samples = integrator.getResults();
+        for (Index k = 0; k < samples.cols(); ++k) {
+            max_error = std::max(max_error, std::abs(pendulum.energy(samples.col(k)) - energy0));
+        }
+        return max_error;
+    };
+    const double rk4 = max_energy_error(Method::RK4);
+    const double verlet = max_energy_error(Method::VelocityVerlet);
+    const double yoshida4 = max_energy_error(Method::Yoshida4);
+    if (verlet > 0.02 || yoshida4 > 1e-3 || rk4 < 100.0 * yoshida4) {
+        std::cerr << "Energy errors: RK4 " << rk4 << ", Verlet " << verlet << ", Yoshida4 " << yoshida4 << std::endl;
+        return 1;
+    }
+
+    // Events interpolate symplectic steps too: small oscillations cross zero at pi / 2
+    Integrator with_event(pendulum, 0.01);
+    with_event.setMethod(Method::Yoshida4);
+    Event zero;
+    zero.g = [](double, const Vec& y) { return y[0]; };
+    zero.terminal = true;
+    with_event.addEvent(zero);
+    Vec small(2);
+    small << 1e-3, 0.0;
+    with_event.integrate(small, 0.0, 10.0);
+    if (!with_event.terminated() || std::abs(with_event.getEventTimes()(0) - M_PI / 2) > 1e-6) {
+        std::cerr << "Zero crossing of the symplectic run is off" << std::endl;
+        return 1;
+    }
+
+    // Systems without a split right-hand side are rejected
+    Lorenz lorenz;
+    Vec x = Vec::Ones(3);
+    Integrator wrong(lorenz, 0.01);
+    wrong.setMethod(Method::VelocityVerlet);
+    try {
+        wrong.integrate(x, 0.0, 1.0);
+        std::cerr << "Symplectic method accepted a non-separable system" << std::endl;
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::cout << "Symplectic integrator test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include "Definitions.hpp"
+#include "Integrator.hpp"
+#include "TrajectoryIO.hpp"
+#include "TrajectorySink.hpp"
+#include "systems/DampedOscillator.hpp"
+
+// Streams a trajectory through sinks and checks it against the in-memory results.
+int main() {
+    DampedOscillator oscillator(1.0, 0.1);
+
+    Vec y(2);
+    y << 0.2, -2.0;
+    Integrator reference(oscillator, 0.001);
+    reference.setTransientTime(1.0);
+    reference.setOutputInterval(0.01);
+    reference.integrate(y, 0.0, 50.0);
+    const Mat& full = reference.getResults();
+
+    RingBufferSink ring(50);
+    Index samples_seen = 0;
+    Index largest_chunk = 0;
+    CallbackSink counter([&](const Eigen::Ref<const Mat>& states, const Eigen::Ref<const Vec>& times) {
+        samples_seen += states.cols();
+        largest_chunk = std::max(largest_chunk, states.cols());
+    });
+
+    Vec y_ring(2);
+    y_ring << 0.2, -2.0;
+    Integrator streaming(oscillator, 0.001);
+    streaming.setTransientTime(1.0);
+    streaming.setOutputInterval(0.01);
+    streaming.setSink(&ring, 64);
+    streaming.integrate(y_ring, 0.0, 50.0);
+
+    Vec y_count(2);
+    y_count << 0.2, -2.0;
+    streaming.setSink(&counter, 64);
+    streaming.integrate(y_count, 0.0, 50.0);
+
+    if (streaming.getResults().cols() != 0) {
+        std::cerr << "Streaming integration must not keep results in memory" << std::endl;
+        return 1;
+    }
+    if (samples_seen != full.cols() || largest_chunk != 64) {
+        std::cerr << "Unexpected chunking: " << samples_seen << " samples, largest chunk " << largest_chunk << std::endl;
+        return 1;
+    }
+    if (ring.size() != 50 || ring.getResults() != full.rightCols(50)
+        || ring.getTimes() != reference.getTimes().tail(50) || y_ring != y) {
+        std::cerr << "Ring buffer does not hold the last samples of the trajectory" << std::endl;
+        return 1;
+    }
+
+    // Binary columnar round trip through the memory-mapped reader
+    const std::string binary_file = (std::filesystem::temp_directory_path() / "nldkit_test_trajectory.nldk").string();
+    TrajectoryMetadata metadata;
+    metadata.values["omega"] = 1.0;
+    reference.writeResultsToBinary(binary_file, metadata);
+    {
+        MappedTrajectory mapped(binary_file);
+        if (mapped.dim() != 2 || mapped.numSamples() != full.cols()
+            || mapped.times() != reference.getTimes() || mapped.columns() != full.transpose()
+            || mapped.metadata().values.at("omega") != 1.0 || mapped.metadata().values.at("dt") != 0.001) {
+            std::cerr << "Binary trajectory round trip failed" << std::endl;
+            return 1;
+        }
+    }
+    std::remove(binary_file.c_str());
+
+    std::cout << "Trajectory sink test passed" << std::endl;
+    return 0;
+}
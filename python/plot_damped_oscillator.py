@@ -9,9 +9,21 @@ plt.style.use(['science', 'grid'])
 script_dir = os.path.dirname(os.path.abspath(__file__))
 csv_file = os.path.join(script_dir, '../data/damped_oscillator.csv')
 
+try:
+    import nldkit  # Built with -DNLDKIT_BUILD_PYTHON=ON
+except ImportError:
+    nldkit = None
 
-# Load the data
-df = pd.read_csv(csv_file)
+# Load the data: integrate in-process when the module is available (same setup as
+# test_damped_oscillator), otherwise read the CSV it wrote
+if nldkit is not None:
+    integrator = nldkit.Integrator(nldkit.DampedOscillator(omega=1.0, gamma=0.1), dt=0.001)
+    integrator.set_output_interval(0.1)
+    integrator.integrate(np.array([0.2, -2.0]), 0.0, 50.0)
+    states = integrator.get_results()  # (2, num_samples) view of the C++ buffer
+    df = pd.DataFrame({'time': integrator.get_times(), 'state_0': states[0], 'state_1': states[1]})
+else:
+    df = pd.read_csv(csv_file)
 
 # Extract parameters for analytic solution
 # Assuming the CSV header: time,state_0 (position),state_1 (velocity)